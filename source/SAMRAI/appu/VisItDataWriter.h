@@ -36,6 +36,7 @@
 #include <list>
 #include <vector>
 #include <memory>
+#include <future>
 
 namespace SAMRAI {
 namespace appu {
@@ -94,6 +95,8 @@ namespace appu {
  *       files.  An optional argument number_procs_per_file, applicable
  *       to parallel runs, sets the number of processors that share a
  *       common dump file.  This can reduce parallel I/O contention.
+ *       The first processor of each group writes the file, and the
+ *       others send it their data.
  *       The default value of this arg is 1.  If the value specified
  *       is greater than the number of processors, then all processors
  *       share a single dump file.
@@ -148,6 +151,11 @@ namespace appu {
  *      specified which will be included as part of the file
  *      information in the dump
  *
+ *    - Optionally, turn on asynchronous writes with
+ *      setAsynchronousWrites().  writePlotData() then returns once the
+ *      data is packed in memory, and the dump files are written in the
+ *      background.  Call flushPlotData() to wait for them.
+ *
  *    - The document "Generating VisIt Visualization Data Files in
  *      SAMRAI" in the SAMRAI documentation directory
  *      (docs/userdocs/VisIt-writer.pdf) gives in-depth details on the
@@ -175,7 +183,9 @@ public:
     * number_procs_per_file is greater than the number of processors,
     * then all processors share a single vis dump file.  Reducing the
     * number of files written may reduce parallel I/O contention and
-    * thus improve I/O efficiency.  The optional argument is_multiblock
+    * thus improve I/O efficiency.  Only the first processor of each
+    * group opens the file; it writes the data of the other processors
+    * of the group as their messages arrive.  The optional argument is_multiblock
     * defaults to false.  It must be set to true for problems on multiblock
     * domains, and left false in all other cases.
     *
@@ -719,6 +729,73 @@ public:
       d_write_ghosts = write_ghosts; 
    }
 
+   /*!
+    * @brief Set the compression of the patch data arrays in the dump
+    * files.
+    *
+    * The settings apply to the processor cluster files, which hold the
+    * patch data.  The summary file is not compressed.  VisIt reads
+    * compressed files transparently.  See
+    * tbox::HDFDatabase::setCompression() for the meaning of the
+    * arguments.  A deflate_level of 0, the default, writes uncompressed
+    * files.
+    *
+    * @pre (deflate_level >= 0) && (deflate_level <= 9)
+    */
+   void
+   setHDFCompression(
+      int deflate_level,
+      bool use_shuffle = true,
+      size_t min_compressed_bytes = 4096,
+      size_t chunk_bytes = 1048576);
+
+   /*!
+    * @brief Turn asynchronous writing of the dump files on or off.
+    *
+    * With asynchronous writes, writePlotData() packs the plot data in
+    * memory and sends it to the file cluster leaders as usual, then
+    * returns while a background thread on each leader writes the
+    * cluster file.  The patch data may be changed as soon as
+    * writePlotData() returns.  The summary file is still written before
+    * writePlotData() returns.
+    *
+    * At most max_dumps_in_flight dumps are written in the background at
+    * once.  When the limit is reached, writePlotData() first waits for
+    * the oldest dump to complete.  Each dump in flight holds a packed
+    * copy of the data of its file cluster.
+    *
+    * The background threads call HDF5, so asynchronous writes need an
+    * HDF5 library built thread-safe.  With any other HDF5 library a
+    * warning is printed and the dump files are written synchronously.
+    *
+    * Turning asynchronous writes off waits for the dumps in flight.
+    *
+    * @param asynchronous_writes True to write dump files in the background.
+    * @param max_dumps_in_flight Maximum number of dumps written at once.
+    *
+    * @pre max_dumps_in_flight > 0
+    */
+   void
+   setAsynchronousWrites(
+      bool asynchronous_writes,
+      int max_dumps_in_flight = 1);
+
+   /*!
+    * @brief Wait until all dump files written in the background by this
+    * processor are complete.
+    *
+    * This is local to the processor.  It is called by the destructor.
+    */
+   void
+   flushPlotData();
+
+   /*!
+    * @brief Return the number of dumps this processor is still writing
+    * in the background.
+    */
+   int
+   getNumberOfDumpsInFlight();
+
 private:
    /*
     * Static integer constant describing version of VisIt Data Writer.
@@ -754,9 +831,18 @@ private:
    static const int VISIT_MASTER;
 
    /*
-    * Static integer constant describing MPI message tag.
+    * Static integer constants describing MPI message tags for sending
+    * processor data to the file cluster leader.
+    */
+   static const int VISIT_FILE_CLUSTER_DATA_TAG0;
+   static const int VISIT_FILE_CLUSTER_DATA_TAG1;
+
+   /*
+    * Static integer constant describing the number of messages the file
+    * cluster leader receives at once.  With two, one message arrives
+    * while the other is written.
     */
-   static const int VISIT_FILE_CLUSTER_WRITE_BATON;
+   static const int VISIT_FILE_CLUSTER_RECVS_IN_FLIGHT;
 
    /*
     * Static boolean that specifies if the summary file (d_summary_filename)
@@ -806,6 +892,22 @@ private:
       int parent;
    };
 
+   /*
+    * Struct to hold the packed data of a file cluster until a background
+    * thread writes the cluster file.  d_buffers[i] holds the data of
+    * processor d_processors[i], packed by Database::putToMessageStream().
+    */
+   struct stagedClusterFile {
+      std::string filename;
+      std::string database_name;
+      int deflate_level;
+      bool use_shuffle;
+      size_t min_compressed_bytes;
+      size_t chunk_bytes;
+      std::vector<int> processors;
+      std::vector<std::vector<char> > buffers;
+   };
+
    /*
     * hier::Variable type:
     *   SCALAR - scalar plot variable (depth = 1)
@@ -1076,13 +1178,51 @@ private:
       const void* s2);
 
    /*
-    * Barrier functions to enable orderly writing of cluster files by
-    * passing a baton from current writer to next proc in cluster.
+    * Write the cluster file on the file cluster leader: the leader's own
+    * data, then the data of the other processors of the cluster as it
+    * arrives.
+    */
+   void
+   writeFileClusterLeaderData(
+      const std::string& visit_HDFFilename,
+      const std::string& database_name,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      double simulation_time);
+
+   /*
+    * Gather the data of the file cluster in memory on the file cluster
+    * leader and return it, to be written later by writeStagedClusterFile().
+    */
+   std::shared_ptr<stagedClusterFile>
+   stageFileClusterLeaderData(
+      const std::string& visit_HDFFilename,
+      const std::string& database_name,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      double simulation_time);
+
+   /*
+    * Write a cluster file gathered by stageFileClusterLeaderData().
+    * This runs on a background thread, so it must not use MPI or any
+    * member of the writer.
+    */
+   static void
+   writeStagedClusterFile(
+      const std::shared_ptr<stagedClusterFile>& staged_file);
+
+   /*
+    * Remove the completed dumps from d_dumps_in_flight.
     */
    void
-   dumpWriteBarrierBegin();
+   reapDumpsInFlight();
+
+   /*
+    * Pack this processor's data in memory and send it to the file
+    * cluster leader.
+    */
    void
-   dumpWriteBarrierEnd();
+   sendFileClusterMemberData(
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      double simulation_time);
 
    /*
     * Write summary data for VisIt to HDF file.
@@ -1281,7 +1421,9 @@ private:
     * is a set of processors that all write VisIt data to
     * a single disk file.  d_processor_on_file_cluster[processorNumber]
     * returns the file_clusterNumber of processorNumber.
-    * d_file_cluster_leader is controller of file_cluster.
+    * d_file_cluster_leader is controller of file_cluster.  The other
+    * processors of the cluster send their data to the leader, which is
+    * the only processor to open the cluster file.
     */
    int d_number_file_clusters;
    int d_my_file_cluster_number;
@@ -1337,6 +1479,23 @@ private:
     */
    bool d_write_ghosts;
 
+   /*
+    * Asynchronous write controls and the background cluster file writes
+    * not yet known to be complete, oldest first.
+    */
+   bool d_asynchronous_writes;
+   int d_max_dumps_in_flight;
+
+   /*
+    * Array compression settings for the cluster files, see
+    * setHDFCompression().
+    */
+   int d_hdf_deflate_level;
+   bool d_hdf_use_shuffle;
+   size_t d_hdf_min_compressed_bytes;
+   size_t d_hdf_chunk_bytes;
+   std::list<std::future<void> > d_dumps_in_flight;
+
    /*
     * brief Storage for strings defining VisIt expressions to be embedded in
     * the plot dump.
@@ -1375,6 +1375,7 @@ public:
    }
 
    friend class BoxIterator;
+   friend class BoxContainer;
 
 #ifdef BOX_TELEMETRY
    // These are to optionally track the cumulative number of Boxes constructed,
@@ -1395,6 +1396,17 @@ private:
     */
    Box();
 
+   /*
+    * Unlock the BoxId, so that a BoxContainer with contiguous storage
+    * can move its Boxes by assignment.  The container locks the ids again
+    * once the Boxes are in place.
+    */
+   void
+   unlockId()
+   {
+      d_id_locked = false;
+   }
+
    static int
    coarsen(
       const int index,
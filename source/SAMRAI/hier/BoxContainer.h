@@ -19,6 +19,7 @@
 #include "SAMRAI/hier/PeriodicShiftCatalog.h"
 #include "SAMRAI/tbox/Utilities.h"
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 #include <set>
@@ -76,6 +77,18 @@ class RealBoxConstIterator;
  * about the Boxes stored in the container, nor will it change the
  * ordered/unordered state of the container.
  *
+ * An ordered container may also use contiguous storage, selected by
+ * makeContiguous().  The Boxes are then kept in a vector sorted by BoxId
+ * instead of in list nodes indexed by a set of pointers.  This uses much
+ * less memory per Box and makes iteration and searches by BoxId cache
+ * friendly, but inserting or erasing a single Box costs O(N) and moves
+ * the Boxes after it, invalidating iterators, pointers and references to
+ * them.  Contiguous storage is meant for large containers that are built
+ * in bulk, with the range version of insert(), and then mostly read, such
+ * as the global Boxes of a BoxLevel.  A contiguous container behaves as
+ * an ordered container in all other respects; in particular the BoxIds of
+ * its Boxes are locked.
+ *
  * @see BoxId
  */
 class BoxContainer
@@ -135,7 +148,10 @@ public:
       {
          if (this != &rhs) {
             d_ordered = rhs.d_ordered;
-            if (d_ordered) {
+            d_contiguous = rhs.d_contiguous;
+            if (d_contiguous) {
+               d_vector_ptr = rhs.d_vector_ptr;
+            } else if (d_ordered) {
                d_set_iter = rhs.d_set_iter;
             } else {
                d_list_iter = rhs.d_list_iter;
@@ -157,7 +173,8 @@ public:
       const Box&
       operator * () const
       {
-         return d_ordered ? **d_set_iter : *d_list_iter;
+         return d_contiguous ? *d_vector_ptr :
+                d_ordered ? **d_set_iter : *d_list_iter;
       }
 
       /*!
@@ -168,7 +185,8 @@ public:
       const Box *
       operator -> () const
       {
-         return d_ordered ? *d_set_iter : &(*d_list_iter);
+         return d_contiguous ? d_vector_ptr :
+                d_ordered ? *d_set_iter : &(*d_list_iter);
       }
 
       /*!
@@ -182,7 +200,9 @@ public:
          int)
       {
          BoxContainerConstIterator return_iter(*this);
-         if (d_ordered) {
+         if (d_contiguous) {
+            ++d_vector_ptr;
+         } else if (d_ordered) {
             ++d_set_iter;
          } else {
             ++d_list_iter;
@@ -199,7 +219,9 @@ public:
       const BoxContainerConstIterator&
       operator ++ ()
       {
-         if (d_ordered) {
+         if (d_contiguous) {
+            ++d_vector_ptr;
+         } else if (d_ordered) {
             ++d_set_iter;
          } else {
             ++d_list_iter;
@@ -218,7 +240,9 @@ public:
          int)
       {
          BoxContainerConstIterator return_iter(*this);
-         if (d_ordered) {
+         if (d_contiguous) {
+            --d_vector_ptr;
+         } else if (d_ordered) {
             --d_set_iter;
          } else {
             --d_list_iter;
@@ -235,7 +259,9 @@ public:
       const BoxContainerConstIterator&
       operator -- ()
       {
-         if (d_ordered) {
+         if (d_contiguous) {
+            --d_vector_ptr;
+         } else if (d_ordered) {
             --d_set_iter;
          } else {
             --d_list_iter;
@@ -254,7 +280,8 @@ public:
       operator == (
          const BoxContainerConstIterator& other) const
       {
-         return d_ordered ? d_set_iter == other.d_set_iter :
+         return d_contiguous ? d_vector_ptr == other.d_vector_ptr :
+                d_ordered ? d_set_iter == other.d_set_iter :
                 d_list_iter == other.d_list_iter;
       }
 
@@ -269,7 +296,8 @@ public:
       operator != (
          const BoxContainerConstIterator& other) const
       {
-         return d_ordered ? d_set_iter != other.d_set_iter :
+         return d_contiguous ? d_vector_ptr != other.d_vector_ptr :
+                d_ordered ? d_set_iter != other.d_set_iter :
                 d_list_iter != other.d_list_iter;
       }
 
@@ -303,7 +331,14 @@ private:
        */
       std::set<Box *, Box::id_less>::const_iterator d_set_iter;
 
+      /*
+       * Underlying pointer to be used when contiguous.
+       */
+      const Box* d_vector_ptr;
+
       bool d_ordered;
+
+      bool d_contiguous;
    };
 
    /*!
@@ -348,7 +383,10 @@ public:
       {
          if (this != &rhs) {
             d_ordered = rhs.d_ordered;
-            if (d_ordered) {
+            d_contiguous = rhs.d_contiguous;
+            if (d_contiguous) {
+               d_vector_ptr = rhs.d_vector_ptr;
+            } else if (d_ordered) {
                d_set_iter = rhs.d_set_iter;
             } else {
                d_list_iter = rhs.d_list_iter;
@@ -370,7 +408,8 @@ public:
       Box&
       operator * () const
       {
-         return d_ordered ? **d_set_iter : *d_list_iter;
+         return d_contiguous ? *d_vector_ptr :
+                d_ordered ? **d_set_iter : *d_list_iter;
       }
 
       /*!
@@ -381,7 +420,8 @@ public:
       Box *
       operator -> () const
       {
-         return d_ordered ? *d_set_iter : &(*d_list_iter);
+         return d_contiguous ? d_vector_ptr :
+                d_ordered ? *d_set_iter : &(*d_list_iter);
       }
 
       /*!
@@ -395,7 +435,9 @@ public:
          int)
       {
          BoxContainerIterator return_iter(*this);
-         if (d_ordered) {
+         if (d_contiguous) {
+            ++d_vector_ptr;
+         } else if (d_ordered) {
             ++d_set_iter;
          } else {
             ++d_list_iter;
@@ -412,7 +454,9 @@ public:
       const BoxContainerIterator&
       operator ++ ()
       {
-         if (d_ordered) {
+         if (d_contiguous) {
+            ++d_vector_ptr;
+         } else if (d_ordered) {
             ++d_set_iter;
          } else {
             ++d_list_iter;
@@ -431,7 +475,9 @@ public:
          int)
       {
          BoxContainerIterator return_iter(*this);
-         if (d_ordered) {
+         if (d_contiguous) {
+            --d_vector_ptr;
+         } else if (d_ordered) {
             --d_set_iter;
          } else {
             --d_list_iter;
@@ -448,7 +494,9 @@ public:
       const BoxContainerIterator&
       operator -- ()
       {
-         if (d_ordered) {
+         if (d_contiguous) {
+            --d_vector_ptr;
+         } else if (d_ordered) {
             --d_set_iter;
          } else {
             --d_list_iter;
@@ -467,7 +515,8 @@ public:
       operator == (
          const BoxContainerIterator& other) const
       {
-         return d_ordered ? d_set_iter == other.d_set_iter :
+         return d_contiguous ? d_vector_ptr == other.d_vector_ptr :
+                d_ordered ? d_set_iter == other.d_set_iter :
                 d_list_iter == other.d_list_iter;
       }
 
@@ -475,7 +524,8 @@ public:
       operator == (
          const BoxContainerConstIterator& other) const
       {
-         return d_ordered ? d_set_iter == other.d_set_iter :
+         return d_contiguous ? d_vector_ptr == other.d_vector_ptr :
+                d_ordered ? d_set_iter == other.d_set_iter :
                 d_list_iter == other.d_list_iter;
       }
 
@@ -490,7 +540,8 @@ public:
       operator != (
          const BoxContainerIterator& other) const
       {
-         return d_ordered ? d_set_iter != other.d_set_iter :
+         return d_contiguous ? d_vector_ptr != other.d_vector_ptr :
+                d_ordered ? d_set_iter != other.d_set_iter :
                 d_list_iter != other.d_list_iter;
       }
 
@@ -498,7 +549,8 @@ public:
       operator != (
          const BoxContainerConstIterator& other) const
       {
-         return d_ordered ? d_set_iter != other.d_set_iter :
+         return d_contiguous ? d_vector_ptr != other.d_vector_ptr :
+                d_ordered ? d_set_iter != other.d_set_iter :
                 d_list_iter != other.d_list_iter;
       }
 
@@ -532,8 +584,15 @@ private:
        */
       std::set<Box *, Box::id_less>::iterator d_set_iter;
 
+      /*
+       * Underlying pointer to be used when contiguous.
+       */
+      Box* d_vector_ptr;
+
       bool d_ordered;
 
+      bool d_contiguous;
+
    };
 
    /*!
@@ -664,6 +723,8 @@ private:
    {
       if (!d_ordered) {
          return static_cast<int>(d_list.size());
+      } else if (d_contiguous) {
+         return static_cast<int>(d_vector.size());
       } else {
          return static_cast<int>(d_set.size());
       }
@@ -694,7 +755,7 @@ private:
    bool
    empty() const
    {
-      return d_list.empty();
+      return d_list.empty() && d_vector.empty();
    }
 
    /*!
@@ -817,7 +878,8 @@ private:
    const Box&
    front() const
    {
-      return d_ordered ? **(d_set.begin()) : d_list.front();
+      return d_contiguous ? d_vector.front() :
+             d_ordered ? **(d_set.begin()) : d_list.front();
    }
 
    /*!
@@ -828,13 +890,15 @@ private:
    const Box&
    back() const
    {
-      return d_ordered ? **(d_set.rbegin()) : d_list.back();
+      return d_contiguous ? d_vector.back() :
+             d_ordered ? **(d_set.rbegin()) : d_list.back();
    }
 
    /*!
     * @brief Remove the member of the container pointed to by "iter".
     *
-    * Can be called on ordered or unordered containers.
+    * Can be called on ordered or unordered containers.  In a contiguous
+    * container, this invalidates iterators at and after iter.
     *
     * @param[in] iter
     */
@@ -866,7 +930,9 @@ private:
    {
       d_list.clear();
       d_set.clear();
+      d_vector.clear();
       d_ordered = false;
+      d_contiguous = false;
       d_tree.reset();
    }
 
@@ -884,9 +950,13 @@ private:
    {
       d_list.swap(other.d_list);
       d_set.swap(other.d_set);
+      d_vector.swap(other.d_vector);
       bool other_set_created = other.d_ordered;
       other.d_ordered = d_ordered;
       d_ordered = other_set_created;
+      bool other_contiguous = other.d_contiguous;
+      other.d_contiguous = d_contiguous;
+      d_contiguous = other_contiguous;
       d_tree.swap(other.d_tree);
    }
 
@@ -1011,11 +1081,65 @@ private:
    /*!
     * @brief Changes state of this container to unordered.
     *
-    * This method can be called on any container.
+    * This method can be called on any container.  A contiguous container
+    * stops using contiguous storage.
     */
    void
    unorder();
 
+   /*!
+    * @brief Changes state of this container to ordered, with the Boxes
+    * in contiguous storage.
+    *
+    * If called on a container that is already contiguous, nothing changes.
+    * Any tree representation is discarded.
+    *
+    * @pre each box in container must have valid and unique BoxId
+    */
+   void
+   makeContiguous();
+
+   /*!
+    * @brief Return whether this container uses contiguous storage.
+    *
+    * A contiguous container is also ordered.
+    */
+   bool
+   isContiguous() const
+   {
+      return d_contiguous;
+   }
+
+   /*!
+    * @brief Set the number of Boxes at or above which containers of
+    * many Boxes, such as the global Boxes of a BoxLevel and the visible
+    * neighbors gathered from a Connector, use contiguous storage.
+    *
+    * The default is 1024.  A negative value disables it.
+    *
+    * @see makeContiguous()
+    */
+   static void
+   setContiguousStorageThreshold(
+      int threshold)
+   {
+      s_contiguous_storage_threshold = threshold;
+   }
+
+   /*!
+    * @brief Return whether a container of the given number of Boxes
+    * should use contiguous storage.
+    *
+    * @see setContiguousStorageThreshold()
+    */
+   static bool
+   useContiguousStorage(
+      size_t num_boxes)
+   {
+      return s_contiguous_storage_threshold >= 0 &&
+             num_boxes >= static_cast<size_t>(s_contiguous_storage_threshold);
+   }
+
    /*!
     * @brief Return whether this container is ordered.
     *
@@ -1484,6 +1608,10 @@ private:
     * container is zero.  If called on such an empty unordered container,
     * the state of the container will be changed to ordered.  A run-time error
     * will occur if called on a non-empty unordered container.
+    *
+    * In a contiguous container, inserting a single Box costs O(N) and
+    * invalidates iterators, so Boxes should be added in bulk with the range
+    * version, which merges the whole range at once.
     */
 
    /*!
@@ -1546,7 +1674,9 @@ private:
     *
     * Boxes in the range [first, last) are added to the ordered container, as
     * long as they do not have a BoxId matching that of a Box already in the
-    * container.
+    * container.  The range may be from an ordered or unordered container,
+    * but not from this container.  If the range has several Boxes with the
+    * same BoxId, the first one is added.
     *
     * @param[in] first
     * @param[in] last
@@ -1560,6 +1690,24 @@ private:
       const_iterator first,
       const_iterator last);
 
+   /*!
+    * @brief  Insert all Boxes within a range of a vector.
+    *
+    * This is the same as the range insert from a container, for Boxes
+    * gathered in a vector.
+    *
+    * @param[in] first
+    * @param[in] last
+    *
+    * @pre empty() || isOrdered()
+    * @pre for each box in [first, last), box.getBoxId().isValid() &&
+    *      (empty || front().getDim() == box.getDim())
+    */
+   void
+   insert(
+      std::vector<Box>::const_iterator first,
+      std::vector<Box>::const_iterator last);
+
    //@}
 
    //@{ @name Methods that may only be called on an ordered container
@@ -1587,8 +1735,17 @@ private:
          TBOX_ERROR("find attempted on unordered BoxContainer." << std::endl);
       }
       iterator iter;
-      iter.d_set_iter = d_set.find(const_cast<Box *>(&box));
       iter.d_ordered = true;
+      if (d_contiguous) {
+         iter.d_contiguous = true;
+         iter.d_vector_ptr = lowerBoundInVector(box);
+         if (iter.d_vector_ptr != vectorEnd() &&
+             iter.d_vector_ptr->getBoxId() != box.getBoxId()) {
+            iter.d_vector_ptr = vectorEnd();
+         }
+      } else {
+         iter.d_set_iter = d_set.find(const_cast<Box *>(&box));
+      }
       return iter;
    }
 
@@ -1613,8 +1770,13 @@ private:
          TBOX_ERROR("lowerBound attempted on unordered BoxContainer." << std::endl);
       }
       iterator iter;
-      iter.d_set_iter = d_set.lower_bound(const_cast<Box *>(&box));
       iter.d_ordered = true;
+      if (d_contiguous) {
+         iter.d_contiguous = true;
+         iter.d_vector_ptr = lowerBoundInVector(box);
+      } else {
+         iter.d_set_iter = d_set.lower_bound(const_cast<Box *>(&box));
+      }
       return iter;
    }
 
@@ -1638,8 +1800,15 @@ private:
          TBOX_ERROR("upperBound attempted on unordered BoxContainer." << std::endl);
       }
       iterator iter;
-      iter.d_set_iter = d_set.upper_bound(const_cast<Box *>(&box));
       iter.d_ordered = true;
+      if (d_contiguous) {
+         iter.d_contiguous = true;
+         iter.d_vector_ptr = vectorBegin()
+            + (std::upper_bound(d_vector.begin(), d_vector.end(), box,
+                  Box::id_less()) - d_vector.begin());
+      } else {
+         iter.d_set_iter = d_set.upper_bound(const_cast<Box *>(&box));
+      }
       return iter;
    }
 
@@ -2023,6 +2192,56 @@ private:
       const IntVector& refinement_ratio,
       bool include_singularity_block_neighbors = false) const;
 
+   /*!
+    * @brief Find the boxes that intersect each of several boxes.
+    *
+    * Pointers to the Boxes in this BoxContainer that intersect the i-th
+    * box of the boxes argument, in iteration order, are added to
+    * overlap_boxes[i].  The searches are divided among threads when
+    * OpenMP is enabled, so this is faster than searching for the boxes
+    * one at a time.
+    *
+    * If this method is used multiple times on the same BoxContainer, it
+    * is recommended for efficiency's sake to call makeTree() on this
+    * BoxContainer before calling this method.
+    *
+    * @param[in,out] overlap_boxes  Resized to boxes.size() if smaller.
+    *
+    * @param[in] boxes
+    *
+    * @pre !hasTree() || (d_tree->getNumberBlocksInTree() == 1)
+    */
+   void
+   findOverlapBoxes(
+      std::vector<std::vector<const Box *> >& overlap_boxes,
+      const BoxContainer& boxes) const;
+
+   /*!
+    * @brief Find the boxes that intersect each of several boxes, using
+    * refinement ratio and grid geometry to handle intersections across
+    * block boundaries.
+    *
+    * The makeTree method with a non-null BaseGridGeometry pointer must
+    * be called on this container before calling this method.  The
+    * output is as in the single-block version of this method.
+    *
+    * @param[in,out] overlap_boxes  Resized to boxes.size() if smaller.
+    *
+    * @param[in] boxes
+    *
+    * @param[in] refinement_ratio
+    *
+    * @param[in] include_singularity_block_neighbors
+    *
+    * @pre hasTree()
+    */
+   void
+   findOverlapBoxes(
+      std::vector<std::vector<const Box *> >& overlap_boxes,
+      const BoxContainer& boxes,
+      const IntVector& refinement_ratio,
+      bool include_singularity_block_neighbors = false) const;
+
    /*!
     * @brief Determine if a given box intersects with the BoxContainer.
     *
@@ -2049,6 +2268,19 @@ private:
     */
    static const int HIER_BOX_CONTAINER_VERSION;
 
+   /*!
+    * @brief Lock or unlock the BoxIds of the Boxes in contiguous storage.
+    *
+    * The ids are locked, as they are in ordered list storage, except
+    * while the vector is being modified, because moving a Box within the
+    * vector assigns to the Boxes after it.
+    */
+   void
+   lockContiguousIds();
+
+   void
+   unlockContiguousIds();
+
    /*!
     * @brief Remove from each box portions intersecting boxes in takeaway.
     *
@@ -2142,6 +2374,44 @@ private:
       iterator& sublist_end,
       iterator& insertion_pt);
 
+   /*!
+    * @brief Implementation of the range insert methods.
+    */
+   template<class ITERATOR>
+   void
+   insertRange(
+      ITERATOR first,
+      ITERATOR last);
+
+   /*!
+    * @brief Return pointers to the beginning and end of the contiguous
+    * storage, for the contiguous iterators.
+    */
+   Box *
+   vectorBegin() const
+   {
+      return d_vector.empty() ? 0 : const_cast<Box *>(&d_vector[0]);
+   }
+
+   Box *
+   vectorEnd() const
+   {
+      return vectorBegin() + d_vector.size();
+   }
+
+   /*!
+    * @brief Return a pointer to the first Box in contiguous storage with
+    * BoxId not less than that of the given Box.
+    */
+   Box *
+   lowerBoundInVector(
+      const Box& box) const
+   {
+      return vectorBegin()
+             + (std::lower_bound(d_vector.begin(), d_vector.end(), box,
+                   Box::id_less()) - d_vector.begin());
+   }
+
    /*!
     * List that provides the internal storage for the member Boxes.
     */
@@ -2153,8 +2423,18 @@ private:
     */
    std::set<Box *, Box::id_less> d_set;
 
+   /*!
+    * Storage for the member Boxes of contiguous containers, sorted by
+    * BoxId.  Both d_list and d_set are empty when this is used.
+    */
+   std::vector<Box> d_vector;
+
    bool d_ordered;
 
+   bool d_contiguous;
+
+   static int s_contiguous_storage_threshold;
+
    mutable std::shared_ptr<MultiblockBoxTree> d_tree;
 };
 
@@ -485,6 +485,25 @@ public:
    operator != (
       const BoxLevel& rhs) const;
 
+   /*!
+    * @brief Return whether this and another BoxLevel are equal on
+    * every process.
+    *
+    * The local parts are compared as in operator==, and the results are
+    * combined with a global reduction, so unlike operator==, every
+    * process gets the same answer.  This is how to tell whether a
+    * regridded BoxLevel is the same as the one it would replace.
+    *
+    * This method is collective over getMPI().
+    *
+    * @param[in] rhs
+    *
+    * @pre isInitialized() && rhs.isInitialized()
+    */
+   bool
+   isGloballyEqualTo(
+      const BoxLevel& rhs) const;
+
    //@{
    /*!
     * @name Accessors
@@ -35,6 +35,25 @@ namespace hier {
  * neighborhood of the base Box.  This class describes the neighborhoods of a
  * collection of base Boxes.  Each base Box in the collection has a
  * neighborhood of adjacent head Boxes.
+ *
+ * A collection may be switched to compact storage, in compressed sparse
+ * row form, by makeCompact() or built directly in that form by
+ * setCompact().  The BoxIds of the base Boxes are then kept in a sorted
+ * vector, each distinct neighbor is kept once in a vector of Boxes sorted
+ * by BoxId, and each neighborhood is a contiguous range of indices into
+ * that vector.  This takes a small fraction of the memory of the default
+ * storage, which needs several tree nodes per relationship, and lookups
+ * are binary searches.  Compact storage is meant for collections that
+ * are done being built and will only be read.  Any change to the
+ * neighborhoods of a compact collection first converts it back to the
+ * default storage, invalidating all iterators except the one passed to
+ * the changing method, so a compact collection must not be changed
+ * while iterating through it.
+ *
+ * TODO: The neighbors copied out by the getNeighbors() methods, and so
+ * the Connector::NeighborSets built from them, are still BoxContainers
+ * with list storage.  Gathering large neighbor sets into contiguous
+ * BoxContainers (see BoxContainer::makeContiguous()) has not been done.
  */
 class BoxNeighborhoodCollection
 {
@@ -129,6 +148,41 @@ private:
     */
    HeadBoxLinkCt d_nbr_link_ct;
 
+   /*!
+    * @brief Whether the collection is in compact storage.  The pools and
+    * links above are empty when it is.
+    */
+   bool d_compact;
+
+   /*!
+    * @brief The BoxIds of the base Boxes, sorted, in compact storage.
+    */
+   std::vector<BoxId> d_compact_base_boxes;
+
+   /*!
+    * @brief The neighborhood of the i-th base Box in compact storage is
+    * d_compact_adj[d_compact_offsets[i]] through
+    * d_compact_adj[d_compact_offsets[i+1]-1].
+    */
+   std::vector<int> d_compact_offsets;
+
+   /*!
+    * @brief Indices into d_compact_nbrs of the neighbors of each base
+    * Box, ascending within each neighborhood, in compact storage.
+    */
+   std::vector<int> d_compact_adj;
+
+   /*!
+    * @brief The distinct head Boxes, sorted by BoxId, in compact storage.
+    */
+   std::vector<Box> d_compact_nbrs;
+
+   /*
+    * Number of neighborhoods at or above which collections built in
+    * bulk use compact storage.
+    */
+   static int s_compact_storage_threshold;
+
 public:
    // Constructors.
 
@@ -252,6 +306,7 @@ public:
          d_collection = rhs.d_collection;
          d_itr = rhs.d_itr;
          d_base_boxes_itr = rhs.d_base_boxes_itr;
+         d_index = rhs.d_index;
          return *this;
       }
 
@@ -267,6 +322,7 @@ public:
          d_collection = rhs.d_collection;
          d_itr = rhs.d_itr;
          d_base_boxes_itr = rhs.d_base_boxes_itr;
+         d_index = rhs.d_index;
          return *this;
       }
 
@@ -286,7 +342,8 @@ public:
       const BoxId&
       operator * () const
       {
-         return *(d_itr->first);
+         return d_collection->d_compact ?
+                d_collection->d_compact_base_boxes[d_index] : *(d_itr->first);
       }
 
       /*!
@@ -296,7 +353,8 @@ public:
       const BoxId *
       operator -> () const
       {
-         return d_itr->first;
+         return d_collection->d_compact ?
+                &d_collection->d_compact_base_boxes[d_index] : d_itr->first;
       }
 
       /*!
@@ -309,10 +367,7 @@ public:
       {
          // Go to the next base Box.
          ConstIterator tmp = *this;
-         if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
-            ++d_base_boxes_itr;
-            ++d_itr;
-         }
+         ++(*this);
          return tmp;
       }
 
@@ -324,7 +379,11 @@ public:
       operator ++ ()
       {
          // Go to the next base Box.
-         if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
+         if (d_collection->d_compact) {
+            if (d_index < d_collection->d_compact_base_boxes.size()) {
+               ++d_index;
+            }
+         } else if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
             ++d_base_boxes_itr;
             ++d_itr;
          }
@@ -340,8 +399,13 @@ public:
       operator == (
          const ConstIterator& rhs) const
       {
-         return d_collection == rhs.d_collection &&
-                d_itr == rhs.d_itr &&
+         if (d_collection != rhs.d_collection) {
+            return false;
+         }
+         if (d_collection->d_compact) {
+            return d_index == rhs.d_index;
+         }
+         return d_itr == rhs.d_itr &&
                 d_base_boxes_itr == rhs.d_base_boxes_itr;
       }
 
@@ -373,11 +437,27 @@ private:
          const BoxNeighborhoodCollection& nbrhds,
          AdjListConstItr itr);
 
+      /*!
+       * @brief Constructs an iterator pointing to the base Box at the
+       * given position in compact storage.  Should only be called by
+       * BoxNeighborhoodCollection.
+       *
+       * @param nbrhds
+       *
+       * @param index
+       */
+      ConstIterator(
+         const BoxNeighborhoodCollection& nbrhds,
+         size_t index);
+
       const BoxNeighborhoodCollection* d_collection;
 
       AdjListConstItr d_itr;
 
       BaseBoxPoolItr d_base_boxes_itr;
+
+      // Position of the base Box when the collection is compact.
+      size_t d_index;
    };
 
    class NeighborIterator;
@@ -428,6 +508,7 @@ public:
          d_collection = rhs.d_collection;
          d_itr = rhs.d_itr;
          d_base_boxes_itr = rhs.d_base_boxes_itr;
+         d_index = rhs.d_index;
          return *this;
       }
 
@@ -447,7 +528,8 @@ public:
       const BoxId&
       operator * () const
       {
-         return *(d_itr->first);
+         return d_collection->d_compact ?
+                d_collection->d_compact_base_boxes[d_index] : *(d_itr->first);
       }
 
       /*!
@@ -457,7 +539,8 @@ public:
       const BoxId *
       operator -> () const
       {
-         return d_itr->first;
+         return d_collection->d_compact ?
+                &d_collection->d_compact_base_boxes[d_index] : d_itr->first;
       }
 
       /*!
@@ -470,10 +553,7 @@ public:
       {
          // Go to the next base Box.
          Iterator tmp = *this;
-         if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
-            ++d_base_boxes_itr;
-            ++d_itr;
-         }
+         ++(*this);
          return tmp;
       }
 
@@ -485,7 +565,11 @@ public:
       operator ++ ()
       {
          // Go to the next base Box.
-         if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
+         if (d_collection->d_compact) {
+            if (d_index < d_collection->d_compact_base_boxes.size()) {
+               ++d_index;
+            }
+         } else if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
             ++d_base_boxes_itr;
             ++d_itr;
          }
@@ -501,8 +585,13 @@ public:
       operator == (
          const Iterator& rhs) const
       {
-         return d_collection == rhs.d_collection &&
-                d_itr == rhs.d_itr &&
+         if (d_collection != rhs.d_collection) {
+            return false;
+         }
+         if (d_collection->d_compact) {
+            return d_index == rhs.d_index;
+         }
+         return d_itr == rhs.d_itr &&
                 d_base_boxes_itr == rhs.d_base_boxes_itr;
       }
 
@@ -534,11 +623,27 @@ private:
          BoxNeighborhoodCollection& nbrhds,
          AdjListItr itr);
 
+      /*!
+       * @brief Constructs an iterator pointing to the base Box at the
+       * given position in compact storage.  Should only be called by
+       * BoxNeighborhoodCollection.
+       *
+       * @param nbrhds
+       *
+       * @param index
+       */
+      Iterator(
+         BoxNeighborhoodCollection& nbrhds,
+         size_t index);
+
       const BoxNeighborhoodCollection* d_collection;
 
       AdjListItr d_itr;
 
       BaseBoxPoolItr d_base_boxes_itr;
+
+      // Position of the base Box when the collection is compact.
+      size_t d_index;
    };
 
    /*!
@@ -601,6 +706,7 @@ public:
          d_collection = rhs.d_collection;
          d_base_box = rhs.d_base_box;
          d_itr = rhs.d_itr;
+         d_compact_itr = rhs.d_compact_itr;
          return *this;
       }
 
@@ -616,6 +722,7 @@ public:
          d_collection = rhs.d_collection;
          d_base_box = rhs.d_base_box;
          d_itr = rhs.d_itr;
+         d_compact_itr = rhs.d_compact_itr;
          return *this;
       }
 
@@ -635,7 +742,8 @@ public:
       const Box&
       operator * () const
       {
-         return *(*d_itr);
+         return d_collection->d_compact ?
+                d_collection->d_compact_nbrs[*d_compact_itr] : *(*d_itr);
       }
 
       /*!
@@ -645,7 +753,8 @@ public:
       const Box *
       operator -> () const
       {
-         return *d_itr;
+         return d_collection->d_compact ?
+                &d_collection->d_compact_nbrs[*d_compact_itr] : *d_itr;
       }
 
       /*!
@@ -657,9 +766,7 @@ public:
          int)
       {
          ConstNeighborIterator tmp = *this;
-         if (d_itr != d_collection->d_adj_list.find(d_base_box)->second.end()) {
-            ++d_itr;
-         }
+         ++(*this);
          return tmp;
       }
 
@@ -670,7 +777,10 @@ public:
       ConstNeighborIterator&
       operator ++ ()
       {
-         if (d_itr != d_collection->d_adj_list.find(d_base_box)->second.end()) {
+         if (d_collection->d_compact) {
+            ++d_compact_itr;
+         } else if (d_itr !=
+                    d_collection->d_adj_list.find(d_base_box)->second.end()) {
             ++d_itr;
          }
          return *this;
@@ -685,9 +795,12 @@ public:
       operator == (
          const ConstNeighborIterator& rhs) const
       {
-         return d_collection == rhs.d_collection &&
-                d_base_box == rhs.d_base_box &&
-                d_itr == rhs.d_itr;
+         if (d_collection != rhs.d_collection ||
+             d_base_box != rhs.d_base_box) {
+            return false;
+         }
+         return d_collection->d_compact ?
+                d_compact_itr == rhs.d_compact_itr : d_itr == rhs.d_itr;
       }
 
       /*!
@@ -711,6 +824,9 @@ private:
       const BoxId* d_base_box;
 
       NeighborhoodConstItr d_itr;
+
+      // Position in d_compact_adj when the collection is compact.
+      const int* d_compact_itr;
    };
 
    /*!
@@ -760,6 +876,7 @@ public:
          d_collection = rhs.d_collection;
          d_base_box = rhs.d_base_box;
          d_itr = rhs.d_itr;
+         d_compact_itr = rhs.d_compact_itr;
          return *this;
       }
 
@@ -779,7 +896,8 @@ public:
       const Box&
       operator * () const
       {
-         return *(*d_itr);
+         return d_collection->d_compact ?
+                d_collection->d_compact_nbrs[*d_compact_itr] : *(*d_itr);
       }
 
       /*!
@@ -789,7 +907,8 @@ public:
       const Box *
       operator -> () const
       {
-         return *d_itr;
+         return d_collection->d_compact ?
+                &d_collection->d_compact_nbrs[*d_compact_itr] : *d_itr;
       }
 
       /*!
@@ -801,9 +920,7 @@ public:
          int)
       {
          NeighborIterator tmp = *this;
-         if (d_itr != d_collection->d_adj_list.find(d_base_box)->second.end()) {
-            ++d_itr;
-         }
+         ++(*this);
          return tmp;
       }
 
@@ -814,7 +931,10 @@ public:
       NeighborIterator&
       operator ++ ()
       {
-         if (d_itr != d_collection->d_adj_list.find(d_base_box)->second.end()) {
+         if (d_collection->d_compact) {
+            ++d_compact_itr;
+         } else if (d_itr !=
+                    d_collection->d_adj_list.find(d_base_box)->second.end()) {
             ++d_itr;
          }
          return *this;
@@ -829,9 +949,12 @@ public:
       operator == (
          const NeighborIterator& rhs) const
       {
-         return d_collection == rhs.d_collection &&
-                d_base_box == rhs.d_base_box &&
-                d_itr == rhs.d_itr;
+         if (d_collection != rhs.d_collection ||
+             d_base_box != rhs.d_base_box) {
+            return false;
+         }
+         return d_collection->d_compact ?
+                d_compact_itr == rhs.d_compact_itr : d_itr == rhs.d_itr;
       }
 
       /*!
@@ -855,6 +978,9 @@ private:
       const BoxId* d_base_box;
 
       NeighborhoodItr d_itr;
+
+      // Position in d_compact_adj when the collection is compact.
+      const int* d_compact_itr;
    };
 
    /*!
@@ -1041,6 +1167,9 @@ private:
    find(
       const BoxId& base_box_id) const
    {
+      if (d_compact) {
+         return ConstIterator(*this, findCompact(base_box_id));
+      }
       BaseBoxPoolItr base_boxes_itr = d_base_boxes.find(base_box_id);
       if (base_boxes_itr == d_base_boxes.end()) {
          return end();
@@ -1060,6 +1189,9 @@ private:
    find(
       const BoxId& base_box_id)
    {
+      if (d_compact) {
+         return Iterator(*this, findCompact(base_box_id));
+      }
       BaseBoxPoolItr base_boxes_itr = d_base_boxes.find(base_box_id);
       if (base_boxes_itr == d_base_boxes.end()) {
          return end();
@@ -1084,7 +1216,7 @@ private:
    bool
    empty() const
    {
-      return d_base_boxes.empty();
+      return d_compact ? d_compact_base_boxes.empty() : d_base_boxes.empty();
    }
 
    /*!
@@ -1093,7 +1225,8 @@ private:
    int
    numBoxNeighborhoods() const
    {
-      return static_cast<int>(d_base_boxes.size());
+      return static_cast<int>(d_compact ?
+                              d_compact_base_boxes.size() : d_base_boxes.size());
    }
 
    /*!
@@ -1124,6 +1257,10 @@ private:
    {
       TBOX_ASSERT(base_box_itr.d_collection == this);
       TBOX_ASSERT(base_box_itr != end());
+      if (d_compact) {
+         return d_compact_offsets[base_box_itr.d_index] ==
+                d_compact_offsets[base_box_itr.d_index + 1];
+      }
       return base_box_itr.d_itr->second.empty();
    }
 
@@ -1155,6 +1292,10 @@ private:
    {
       TBOX_ASSERT(base_box_itr.d_collection == this);
       TBOX_ASSERT(base_box_itr != end());
+      if (d_compact) {
+         return d_compact_offsets[base_box_itr.d_index + 1] -
+                d_compact_offsets[base_box_itr.d_index];
+      }
       return static_cast<int>(base_box_itr.d_itr->second.size());
    }
 
@@ -1505,6 +1646,85 @@ private:
 
    //@}
 
+   //@{
+   /*!
+    * @name Compact storage
+    */
+
+   /*!
+    * @brief Convert to compact storage.
+    *
+    * If called on a collection that is already compact, nothing changes.
+    * Iterators into the collection are invalidated.
+    */
+   void
+   makeCompact();
+
+   /*!
+    * @brief Return whether this collection is in compact storage.
+    */
+   bool
+   isCompact() const
+   {
+      return d_compact;
+   }
+
+   /*!
+    * @brief Replace the contents with the given neighborhoods, in
+    * compressed sparse row form, and use compact storage.
+    *
+    * The neighbors of the base Box with BoxId base_box_ids[i] are
+    * nbrs[nbr_offsets[i]] through nbrs[nbr_offsets[i+1]-1].  The base
+    * BoxIds must be distinct but need not be sorted, and a neighbor may
+    * appear more than once, in the same or in different neighborhoods.
+    * This builds a large collection much faster than inserting the
+    * neighbors one at a time.
+    *
+    * @param base_box_ids
+    * @param nbr_offsets
+    * @param nbrs
+    *
+    * @pre nbr_offsets.size() == base_box_ids.size() + 1
+    * @pre nbr_offsets[0] == 0
+    * @pre nbr_offsets.back() == nbrs.size()
+    */
+   void
+   setCompact(
+      const std::vector<BoxId>& base_box_ids,
+      const std::vector<int>& nbr_offsets,
+      const std::vector<Box>& nbrs);
+
+   /*!
+    * @brief Set the number of neighborhoods at or above which Connectors
+    * cached by PersistentOverlapConnectors use compact storage.
+    *
+    * The default is 1024.  A negative value disables it.
+    *
+    * @see makeCompact()
+    */
+   static void
+   setCompactStorageThreshold(
+      int threshold)
+   {
+      s_compact_storage_threshold = threshold;
+   }
+
+   /*!
+    * @brief Return whether a collection of the given number of
+    * neighborhoods should use compact storage.
+    *
+    * @see setCompactStorageThreshold()
+    */
+   static bool
+   useCompactStorage(
+      size_t num_neighborhoods)
+   {
+      return s_compact_storage_threshold >= 0 &&
+             num_neighborhoods >= static_cast<size_t>(s_compact_storage_threshold);
+   }
+
+   //@}
+
    //@{
    /*!
     * @name Coarsen, refine, grow.
@@ -1679,6 +1899,44 @@ private:
       tbox::Database& restart_db);
 
    //@}
+
+private:
+   /*
+    * Return the position of the base Box with the given BoxId in compact
+    * storage, or the number of base Boxes if there is none.
+    */
+   size_t
+   findCompact(
+      const BoxId& base_box_id) const;
+
+   /*
+    * Convert compact storage back to the default storage, so that the
+    * neighborhoods can be changed.
+    */
+   void
+   expandCompact();
+
+   /*
+    * Convert compact storage back to the default storage and point
+    * base_box_itr to the same base Box in the default storage.
+    */
+   void
+   expandCompact(
+      Iterator& base_box_itr);
+
+   /*
+    * Keep only the neighborhoods in compact storage for which keep is
+    * true, and the neighbors they reference.
+    */
+   void
+   eraseCompactNeighborhoods(
+      const std::vector<bool>& keep);
+
+   /*
+    * Remove the neighbors in compact storage that are in no neighborhood.
+    */
+   void
+   pruneCompactNeighbors();
 };
 
 }
@@ -17,7 +17,6 @@
 #include "SAMRAI/tbox/Timer.h"
 
 #include <vector>
-#include <list>
 #include <memory>
 
 namespace SAMRAI {
@@ -34,6 +33,13 @@ class BoxContainer;
  * splitting stops when the number of boxes in a leaf node of the tree
  * is less than a minimum number specified in the constructor.
  *
+ * The tree is stored flat: the nodes are held in a vector, in order of
+ * their depth, and refer to their children by index.  The Boxes of
+ * each node are a contiguous range of a single vector of Box pointers.
+ * The nodes at each depth are split independently, in parallel threads
+ * when OpenMP is enabled, and the resulting tree does not depend on the
+ * number of threads.
+ *
  * All boxes in a BoxTree must exist in the same index space.
  * This means that they must all have the same BlockId value.
  *
@@ -41,6 +47,10 @@ class BoxContainer;
  * - hasOverlap()
  * - findOverlapBoxes()
  *
+ * The searches do not change the tree, so any number of threads may
+ * search it at once.  A batch of searches may also be given to a single
+ * findOverlapBoxes() call, which divides them among threads.
+ *
  * Except for two static methods and a destructor needed by shared_ptr,
  * the entire interface is private.
  */
@@ -78,8 +88,20 @@ public:
 
 private:
 
+   /*!
+    * @brief Constructs a BoxTree from pointers to Boxes.
+    *
+    * The Boxes are not copied, so they must outlive the tree.
+    *
+    * @param[in] boxes
+    *
+    * @param[in] min_number  @b Default: 10
+    *
+    * @pre !boxes.empty()
+    * @pre each box in boxes has a valid, identical BlockId
+    */
    BoxTree(
-      const std::list<const Box *> boxes,
+      const std::vector<const Box *>& boxes,
       int min_number = 10);
 
    /*!
@@ -102,17 +124,6 @@ private:
       const BoxContainer& boxes,
       int min_number = 10);
 
-   /*!
-    * @brief Constructor building an uninitialized object.
-    *
-    * Private as it is used only internally to create child trees.
-    * The object can be initialized using generateTree().
-    *
-    * @param[in] dim
-    */
-   explicit BoxTree(
-      const tbox::Dimension& dim);
-
    /*!
     * Default constructor is unimplemented and should not be used.
     */
@@ -122,28 +133,21 @@ private:
     * @brief Reset to uninitialized state.
     *
     * The dimension of boxes in the tree cannot be changed.
-    *
-    * Uninitialized trees can be initialized using generateTree().
     */
    void
    clear()
    {
-      d_bounding_box.setEmpty();
-      d_left_child.reset();
-      d_right_child.reset();
+      d_nodes.clear();
       d_boxes.clear();
-      d_center_child.reset();
    }
 
    /*!
     * @brief Check whether the tree has been initialized.
-    *
-    * Uninitialized trees can be initialized using generateTree().
     */
    bool
    isInitialized() const
    {
-      return !d_bounding_box.empty();
+      return !d_nodes.empty();
    }
 
    //@{
@@ -198,8 +202,9 @@ private:
     *
     * @param[in] box the specified box whose overlaps are requested.
     *
-    * @param[in] recursive_call Disable logging of information except at first
-    * call.
+    * @param[in] recursive_call Disable logging of information.  Searches
+    * done from several threads at once should set this, because the
+    * statistics are not thread-safe.
     *
     * @pre getDim() == box.getDim()
     * @pre box.getBlockId() == getBlockId()
@@ -222,8 +227,7 @@ private:
     *
     * @param[in] box the specified box whose overlaps are requested.
     *
-    * @param[in] recursive_call Disable logging of information except at first
-    * call.
+    * @param[in] recursive_call Disable logging of information.
     *
     * @pre getDim() == box.getDim()
     * @pre box.getBlockId() == getBlockId()
@@ -234,44 +238,166 @@ private:
       const Box& box,
       bool recursive_call = false) const;
 
+   /*!
+    * @brief Find the boxes that overlap each of several boxes.
+    *
+    * Pointers to the Boxes overlapping boxes[i] are added to
+    * overlap_boxes[i], which is not emptied first.  The searches are
+    * divided among threads when OpenMP is enabled.
+    *
+    * @param[in,out] overlap_boxes  Resized to boxes.size() if smaller.
+    *
+    * @param[in] boxes
+    *
+    * @pre each box in boxes has the same dimension as the tree
+    * @pre each box in boxes has the same BlockId as the tree
+    */
+   void
+   findOverlapBoxes(
+      std::vector<std::vector<const Box *> >& overlap_boxes,
+      const std::vector<const Box *>& boxes) const;
+
    //@}
 
    /*!
-    * @brief Private recursive function for generating the search tree.
+    * @brief A node of the tree.
     *
-    * d_boxes is changed in the process (for efficiency reasons).
-    * On output it will contain any boxes that are not assigned to a child
-    * tree.
+    * The node's own Boxes are d_boxes[begin] to d_boxes[end - 1].
+    * These are the Boxes straddling the node's partition plane, unless
+    * there are enough of them to be given to a center child.  Child
+    * indices are -1 for missing children.
+    */
+   struct Node {
+      explicit Node(
+         const tbox::Dimension& dim):
+         bounding_box(dim),
+         left_child(-1),
+         right_child(-1),
+         center_child(-1),
+         begin(0),
+         end(0)
+      {
+      }
+
+      /*!
+       * @brief Bounding box of all the Boxes in this node and its
+       * descendants.
+       */
+      Box bounding_box;
+
+      int left_child;
+      int right_child;
+      int center_child;
+
+      int begin;
+      int end;
+   };
+
+   /*!
+    * @brief Generate the nodes of the tree from the Boxes in d_boxes.
     *
-    * The object is not cleared in this method.  If the object has
-    * been initialized, it should be cleared before calling this
-    * method.  @see clear().
+    * The nodes are generated one depth at a time, and the nodes at the
+    * same depth are split concurrently.
     *
-    * @param min_number  @b Default: 10
+    * @param min_number
     */
    void
-   privateGenerateTree(
-      int min_number = 10);
+   generateTree(
+      int min_number);
 
    /*!
-    * @brief Set up the child branches.
+    * @brief Compute a node's bounding box and, if it has more than
+    * min_number Boxes, partition its Boxes.
     *
-    * This method is called after splitting the Boxes into the
-    * left_boxes and right_boxes, with boxes straddling
-    * the divider stored in d_boxes.  It generates
-    * d_left_child, d_right_child and, if needed, d_center_child.
+    * The Boxes in the node's range are reordered so that those below the
+    * midpoint of the longest direction of the bounding box come first,
+    * then those straddling it, then those above it.  The relative order
+    * of Boxes within each group is preserved.
     *
-    * @param[in] min_number
+    * @param[in,out] node
     *
-    * @param[in,out] left_boxes
+    * @param[out] left_end  End of the Boxes below the midpoint.
     *
-    * @param[in,out] right_boxes
+    * @param[out] center_end  End of the Boxes straddling the midpoint.
+    *
+    * @param[in] min_number
+    */
+   void
+   splitNode(
+      Node& node,
+      int& left_end,
+      int& center_end,
+      int min_number);
+
+   /*!
+    * @brief Whether box overlaps a Box of a node or its descendants.
+    */
+   bool
+   hasOverlapInNode(
+      const Box& box,
+      int node_index) const;
+
+   /*!
+    * @brief Add the Boxes of a node and its descendants that overlap box.
+    */
+   void
+   findOverlapBoxesInNode(
+      std::vector<const Box *>& overlap_boxes,
+      const Box& box,
+      int node_index) const;
+
+   /*!
+    * @brief Add the Boxes of a node and its descendants that overlap box.
     */
    void
-   setupChildren(
-      const int min_number,
-      std::list<const Box*>& left_boxes,
-      std::list<const Box*>& right_boxes);
+   findOverlapBoxesInNode(
+      BoxContainer& overlap_boxes,
+      const Box& box,
+      int node_index) const;
+
+   /*!
+    * @brief Predicate for Boxes not extending above a plane.
+    */
+   struct UpperNotAbove {
+      UpperNotAbove(
+         tbox::Dimension::dir_t dir,
+         int plane):
+         d_dir(dir),
+         d_plane(plane)
+      {
+      }
+
+      bool
+      operator () (const Box* box) const
+      {
+         return box->upper(d_dir) <= d_plane;
+      }
+
+      tbox::Dimension::dir_t d_dir;
+      int d_plane;
+   };
+
+   /*!
+    * @brief Predicate for Boxes not starting above a plane.
+    */
+   struct LowerNotAbove {
+      LowerNotAbove(
+         tbox::Dimension::dir_t dir,
+         int plane):
+         d_dir(dir),
+         d_plane(plane)
+      {
+      }
+
+      bool
+      operator () (const Box* box) const
+      {
+         return box->lower(d_dir) <= d_plane;
+      }
+
+      tbox::Dimension::dir_t d_dir;
+      int d_plane;
+   };
 
    /*!
     * @brief Set up static class members.
@@ -295,40 +421,21 @@ private:
     */
    const tbox::Dimension d_dim;
 
-   /*!
-    * @brief Bounding box of all the Boxes in this tree.
-    */
-   Box d_bounding_box;
-
    /*!
     * @brief BlockId
     */
    BlockId d_block_id;
 
    /*!
-    * std::shared_ptrs to familial boxes.
-    */
-   std::shared_ptr<BoxTree> d_left_child;
-   std::shared_ptr<BoxTree> d_right_child;
-
-   /*!
-    * @brief A tree for Boxes that are not given to the left or
-    * right children.
-    */
-   std::shared_ptr<BoxTree> d_center_child;
-
-   /*!
-    * @brief Boxes that are contained within the physical domain
-    * that this tree represents.  When we have a small number of boxes
-    * that do not warant the overhead of a child tree, the boxes go here.
+    * @brief Nodes of the tree, in order of depth.  The root is the
+    * first node.
     */
-   std::list<const Box*> d_boxes;
+   std::vector<Node> d_nodes;
 
    /*!
-    * @brief Dimension along which the input box triples are
-    * partitioned.
+    * @brief The Boxes in the tree, grouped by the nodes owning them.
     */
-   tbox::Dimension::dir_t d_partition_dir;
+   std::vector<const Box *> d_boxes;
 
    /*
     * Timers are static to keep the objects light-weight.
@@ -662,6 +662,32 @@ public:
       d_global_data_up_to_date = false;
    }
 
+   /*!
+    * @brief Switch the local neighborhoods to compact storage.
+    *
+    * This is meant for Connectors that are done being built and will only
+    * be searched and iterated, such as those cached by
+    * PersistentOverlapConnectors.  Modifying the neighborhoods afterward
+    * switches them back to the default storage and invalidates all
+    * iterators into them.
+    *
+    * @see BoxNeighborhoodCollection::makeCompact()
+    */
+   void
+   makeCompact()
+   {
+      d_relationships.makeCompact();
+   }
+
+   /*!
+    * @brief Returns true if the local neighborhoods are in compact storage.
+    */
+   bool
+   isCompact() const
+   {
+      return d_relationships.isCompact();
+   }
+
    /*!
     * @brief Returns true is the neighborhood of the supplied BoxId is empty.
     *
@@ -240,8 +240,71 @@ private:
       const IntVector& refinement_ratio,
       bool include_singularity_block_neighbors = false) const;
 
+   /*!
+    * @brief Find the boxes that intersect each of several boxes.
+    *
+    * Pointers to the Boxes in the tree that intersect boxes[i] are
+    * added to overlap_boxes[i].  The searches are divided among threads
+    * when OpenMP is enabled.
+    *
+    * This only works if the tree represents Boxes all having the same
+    * BlockId.  Boxes with a different BlockId have no overlaps.
+    *
+    * @param[in,out] overlap_boxes  Resized to boxes.size() if smaller.
+    *
+    * @param[in] boxes
+    *
+    * @pre getNumberBlocksInTree() == 1
+    */
+   void
+   findOverlapBoxes(
+      std::vector<std::vector<const Box *> >& overlap_boxes,
+      const std::vector<const Box *>& boxes) const;
+
+   /*!
+    * @brief Find the boxes that intersect each of several boxes.
+    *
+    * Uses refinement ratio and grid geometry to handle intersections
+    * across block boundaries if needed.
+    *
+    * Pointers to the Boxes in the tree that intersect boxes[i] are
+    * added to overlap_boxes[i].  The searches are divided among threads
+    * when OpenMP is enabled.
+    *
+    * @param[in,out] overlap_boxes  Resized to boxes.size() if smaller.
+    *
+    * @param[in] boxes
+    *
+    * @param[in] refinement_ratio
+    *
+    * @param[in] include_singularity_block_neighbors
+    *
+    * @see findOverlapBoxes(std::vector<const Box *>&, const Box&,
+    * const IntVector&, bool) const
+    */
+   void
+   findOverlapBoxes(
+      std::vector<std::vector<const Box *> >& overlap_boxes,
+      const std::vector<const Box *>& boxes,
+      const IntVector& refinement_ratio,
+      bool include_singularity_block_neighbors = false) const;
+
    //@}
 
+   /*!
+    * @brief Implementation of the multiblock search for one box.
+    *
+    * @param[in] recursive_call  If true, do not record BoxTree
+    * statistics, which are not thread-safe.
+    */
+   void
+   findOverlapBoxesInBlocks(
+      std::vector<const Box *>& overlap_boxes,
+      const Box& box,
+      const IntVector& refinement_ratio,
+      bool include_singularity_block_neighbors,
+      bool recursive_call) const;
+
 private:
    /*!
     * @brief Container of single-block BoxTrees.
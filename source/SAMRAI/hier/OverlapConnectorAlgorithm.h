@@ -16,10 +16,13 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 namespace SAMRAI {
 namespace hier {
 
+class AssumedPartition;
+
 /*!
  * @brief Algorithms for working Connectors whose neighbor data
  * represents overlaps.
@@ -332,6 +335,54 @@ public:
       const IntVector& connector_width_limit,
       bool compute_transpose) const;
 
+   /*!
+    * @brief Begin a bridgeWithNesting and defer its completion to
+    * finishBridges().
+    *
+    * The local discovery is done and the messages to other processes
+    * are sent, but the messages from other processes are not received.
+    * Beginning several independent bridges before finishing them
+    * overlaps the communication of each bridge with the discovery of
+    * the ones begun after it.
+    *
+    * @b west_to_east is allocated immediately but is incomplete until
+    * finishBridges() is called.  Until then, it must not be used, the
+    * input Connectors and their BoxLevels must not be changed and no
+    * other communication should be done with the OverlapConnectorAlgorithm's
+    * SAMRAI_MPI.  All processes must begin their bridges in the same
+    * order.
+    *
+    * The arguments are the same as for bridgeWithNesting().
+    *
+    * @pre west_to_cent.hasTranspose()
+    * @pre cent_to_east.hasTranspose()
+    */
+   void
+   beginBridgeWithNesting(
+      std::shared_ptr<Connector>& west_to_east,
+      const Connector& west_to_center,
+      const Connector& center_to_east,
+      const IntVector& center_growth_to_nest_west,
+      const IntVector& center_growth_to_nest_east,
+      const IntVector& connector_width_limit,
+      bool compute_transpose) const;
+
+   /*!
+    * @brief Complete all bridges begun by beginBridgeWithNesting(),
+    * in the order they were begun.
+    */
+   void
+   finishBridges() const;
+
+   /*!
+    * @brief Return whether there are bridges begun but not finished.
+    */
+   bool
+   hasPendingBridges() const
+   {
+      return !d_pending_bridges.empty();
+   }
+
    /*!
     * @brief A version of bridge without any guarantee of nesting.
     *
@@ -525,6 +576,37 @@ private:
    // Internal shorthand.
    typedef Connector::NeighborSet NeighborSet;
 
+   /*
+    * @brief State of a bridge between the sending and receiving phases
+    * of privateBridge.
+    */
+   struct PendingBridge {
+      PendingBridge(
+         Connector& west_to_east_,
+         Connector* east_to_west_,
+         bool compute_transpose_,
+         const std::set<int>& incoming_ranks_,
+         const tbox::SAMRAI_MPI& mpi_);
+
+      ~PendingBridge();
+
+      Connector* west_to_east;
+      Connector* east_to_west;
+      bool compute_transpose;
+      std::set<int> incoming_ranks;
+      tbox::SAMRAI_MPI mpi;
+      tbox::AsyncCommStage comm_stage;
+      tbox::AsyncCommPeer<int>* all_comms;
+
+private:
+      // The following are not implemented:
+      PendingBridge(
+         const PendingBridge&);
+      PendingBridge&
+      operator = (
+         const PendingBridge&);
+   };
+
    void
    privateBridge_prologue(
       const Connector& west_to_cent,
@@ -576,6 +658,48 @@ private:
       NeighborSet& visible_west_nabrs,
       NeighborSet& visible_east_nabrs) const;
 
+   /*!
+    * @brief Set up the result Connectors of bridgeWithNesting and
+    * begin the bridge.
+    */
+   std::shared_ptr<PendingBridge>
+   privateBridgeWithNesting_begin(
+      std::shared_ptr<Connector>& west_to_east,
+      const Connector& west_to_center,
+      const Connector& center_to_east,
+      const IntVector& center_growth_to_nest_west,
+      const IntVector& center_growth_to_nest_east,
+      const IntVector& connector_width_limit,
+      bool compute_transpose) const;
+
+   /*!
+    * @brief Sending phase of privateBridge: set up the communication,
+    * discover the overlaps and send the remote ones.
+    */
+   void
+   privateBridge_begin(
+      PendingBridge& pending,
+      const Connector& cent_to_east,
+      const std::set<int>& outgoing_ranks,
+      NeighborSet& visible_west_nabrs,
+      NeighborSet& visible_east_nabrs) const;
+
+   /*!
+    * @brief Receiving phase of privateBridge: receive and unpack the
+    * overlaps discovered by other processes.
+    */
+   void
+   privateBridge_finish(
+      PendingBridge& pending) const;
+
+   /*!
+    * @brief Set the transpose of a Connector computed by
+    * bridgeWithNesting.
+    */
+   void
+   privateBridgeWithNesting_setTranspose(
+      PendingBridge& pending) const;
+
    /*
     * @brief Perform checks on the arguments of bridge.
     */
@@ -657,6 +781,22 @@ private:
       const IntVector& neighbor_refinement_ratio,
       const PeriodicShiftCatalog& shift_catalog) const;
 
+   /*!
+    * @brief Find the assumed partition boxes overlapping each of the
+    * given boxes and add them as neighbors in a Connector to the
+    * center BoxLevel, used in findOverlaps_assumedPartition().
+    *
+    * The searches are divided among threads and the neighbors are
+    * inserted in the order of the boxes.
+    */
+   void
+   privateFindOverlaps_connectToAssumedPartition(
+      Connector& to_center,
+      const BoxContainer& boxes,
+      const AssumedPartition& center_ap,
+      const BaseGridGeometry& grid_geometry,
+      const IntVector& center_refinement_ratio) const;
+
    /*!
     * @brief Set up things for the entire class.
     *
@@ -755,6 +895,12 @@ private:
    bool d_sanity_check_method_preconditions;
    bool d_sanity_check_method_postconditions;
 
+   /*!
+    * @brief Bridges begun by beginBridgeWithNesting() and not yet
+    * finished, in the order begun.
+    */
+   mutable std::vector<std::shared_ptr<PendingBridge> > d_pending_bridges;
+
    static tbox::StartupShutdownManager::Handler s_initialize_finalize_handler;
 
 };
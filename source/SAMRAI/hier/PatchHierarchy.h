@@ -1031,6 +1031,57 @@ public:
    void
    initializeHierarchy();
 
+   /*!
+    * @brief Read the boxes of every level of a hierarchy from a restart
+    * written by a different number of processors.
+    *
+    * This is the first step of restoring a hierarchy from such a
+    * restart, which initializeHierarchy() cannot do.  Each processor
+    * reads the level boxes written by some of the processors that wrote
+    * the restart, and the boxes are then shared, so that on return every
+    * processor has all of them.  The boxes keep the BoxIds they were
+    * written with, so their owner ranks are those of the processors that
+    * wrote the restart.  On return the hierarchy has no levels.
+    *
+    * The caller then makes each level, from level 0 up, with
+    * makeNewPatchLevel() from boxes covering the same index space, such
+    * as a load balanced partition of the stored boxes, and calls
+    * initializeRedistributedHierarchy().  GriddingAlgorithm does this
+    * using its load balancers.
+    *
+    * This is collective.
+    *
+    * @param[out] stored_boxes stored_boxes[ln] gets the boxes of level
+    * ln, without periodic images.
+    *
+    * @pre tbox::RestartManager::getManager()->isFromRestart()
+    */
+   void
+   getStoredBoxesFromRestart(
+      std::vector<BoxContainer>& stored_boxes);
+
+   /*!
+    * @brief Finish restoring a hierarchy from a restart written by a
+    * different number of processors.
+    *
+    * Each processor reads the restart patch data of the stored patches
+    * overlapping its own patches, and copies it into them.  Only the
+    * restart files of the processors that wrote those stored patches
+    * are opened.  The data are copied wherever the interior of a stored
+    * patch covers them.  Ghost cells outside every stored interior, such
+    * as those at physical and periodic boundaries, are copied from the
+    * ghost data of the stored patches that have them.  Connectors are
+    * then computed as in initializeHierarchy().
+    *
+    * @param[in] stored_boxes The boxes from getStoredBoxesFromRestart()
+    *
+    * @pre getNumberOfLevels() == stored_boxes.size()
+    * @pre every level has been made
+    */
+   void
+   initializeRedistributedHierarchy(
+      const std::vector<BoxContainer>& stored_boxes);
+
    /*!
     * @brief Get the dimension of this object.
     *
@@ -1137,6 +1188,12 @@ private:
    void
    getFromRestart();
 
+   /*!
+    * @brief Compute the Connectors of every level restored from restart.
+    */
+   void
+   createConnectorsFromRestart();
+
    /*!
     * @brief Free static timers.
     *
@@ -1101,6 +1101,28 @@ public:
    putToRestart(
       const std::shared_ptr<tbox::Database>& restart_db) const;
 
+   /*!
+    * @brief Return the name of the restart database of a patch.
+    *
+    * putToRestart() writes each patch to a database of this name within
+    * the database of its level.
+    *
+    * @param[in]  level_number Number of the level of the patch
+    * @param[in]  box Box of the patch
+    */
+   static std::string
+   getPatchRestartName(
+      int level_number,
+      const Box& box)
+   {
+      return "level_" + tbox::Utilities::levelToString(level_number)
+             + "-patch_"
+             + tbox::Utilities::patchToString(box.getLocalId().getValue())
+             + "-block_"
+             + tbox::Utilities::blockToString(
+                static_cast<int>(box.getBlockId().getBlockValue()));
+   }
+
    /*!
     * @brief Print a patch level to varying details.
     *
@@ -342,6 +342,18 @@ private:
    postprocessForEmptyNeighborContainers(
       Connector& connector);
 
+   /*
+    * @brief Switch a Connector entering the collection to compact
+    * storage if it is large enough.
+    *
+    * Connectors handed out by the collection are const, so they are only
+    * read from here on.  Connectors that are still being modified are
+    * left in the default storage.
+    */
+   void
+   compactForCaching(
+      Connector& connector);
+
    //@}
 
    //@{
@@ -622,6 +622,21 @@ public:
       const int denom_id,
       bool local_only = false) const;
 
+   /**
+    * Perform the operations in the batch and reduce its norms and dot
+    * products across processors together.  All operations are done on
+    * each patch before moving to the next patch, so the hierarchy is
+    * swept only once.
+    *
+    * @pre getPatchHierarchy()
+    * @pre (d_coarsest_level >= 0) && (d_finest_level >= d_coarsest_level) &&
+    *      (d_finest_level <= getPatchHierarchy()->getFinestLevelNumber())
+    */
+   void
+   computeBatch(
+      HierarchyDataOpsBatchReal<TYPE>& batch,
+      bool local_only = false) const;
+
 private:
    // The following are not implemented
    HierarchyCellDataOpsReal(
@@ -0,0 +1,316 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   Batch of operations for real data on hierarchy.
+ *
+ ************************************************************************/
+
+#ifndef included_math_HierarchyDataOpsBatchReal
+#define included_math_HierarchyDataOpsBatchReal
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include <vector>
+
+namespace SAMRAI {
+namespace math {
+
+/**
+ * Class HierarchyDataOpsBatchReal<TYPE> holds a sequence of operations
+ * on real data over a patch hierarchy, to be performed together by
+ * HierarchyDataOpsReal<TYPE>::computeBatch().
+ *
+ * Performing the operations together allows the hierarchy data
+ * operations to make one pass over the patches, doing all of the
+ * operations on each patch while its data is in cache, and to reduce
+ * all norms and dot products across processors with a single
+ * collective operation, instead of one collective operation per result.
+ *
+ * The operations are done in the order they are added, so a norm added
+ * after an update is computed from the updated data.  Each norm or dot
+ * product is given a result index when it is added; the result can be
+ * retrieved with getResult() after the batch has been computed.  A
+ * batch may be computed any number of times, and cleared for reuse.
+ *
+ * Typical use, for the update and residual norm of an iterative solver:
+ *
+ * \verbatim
+ * HierarchyDataOpsBatchReal<double> batch;
+ * batch.addAxpy(x_id, alpha, p_id, x_id);
+ * batch.addAxpy(r_id, -alpha, q_id, r_id);
+ * size_t rnorm = batch.addL2Norm(r_id, vol_id);
+ * size_t rz = batch.addDot(r_id, z_id, vol_id);
+ * ops->computeBatch(batch);
+ * double residual = batch.getResult(rnorm);
+ * \endverbatim
+ *
+ * @see HierarchyDataOpsReal
+ */
+
+template<class TYPE>
+class HierarchyDataOpsBatchReal
+{
+public:
+   /**
+    * Kinds of operations in a batch.  The update operations have the
+    * semantics of the HierarchyDataOpsReal methods of the same name.
+    * The reductions produce a result.
+    */
+   enum OperationType {
+      COPY_DATA,
+      SET_TO_SCALAR,
+      SCALE,
+      LINEAR_SUM,
+      AXPY,
+      L1_NORM,
+      L2_NORM,
+      MAX_NORM,
+      DOT
+   };
+
+   /**
+    * Description of one operation.  Unused members are -1 or zero.
+    */
+   struct Operation {
+      OperationType type;
+      int dst_id;
+      int src1_id;
+      int src2_id;
+      int vol_id;
+      TYPE alpha;
+      TYPE beta;
+      bool interior_only;
+      size_t result;
+   };
+
+   /**
+    * Empty constructor and destructor.
+    */
+   HierarchyDataOpsBatchReal();
+
+   ~HierarchyDataOpsBatchReal();
+
+   /**
+    * Add dst = src.
+    */
+   void
+   addCopyData(
+      const int dst_id,
+      const int src_id,
+      const bool interior_only = true);
+
+   /**
+    * Add dst = alpha.
+    */
+   void
+   addSetToScalar(
+      const int dst_id,
+      const TYPE& alpha,
+      const bool interior_only = true);
+
+   /**
+    * Add dst = alpha * src.
+    */
+   void
+   addScale(
+      const int dst_id,
+      const TYPE& alpha,
+      const int src_id,
+      const bool interior_only = true);
+
+   /**
+    * Add dst = alpha * src1 + beta * src2.
+    */
+   void
+   addLinearSum(
+      const int dst_id,
+      const TYPE& alpha,
+      const int src1_id,
+      const TYPE& beta,
+      const int src2_id,
+      const bool interior_only = true);
+
+   /**
+    * Add dst = alpha * src1 + src2.
+    */
+   void
+   addAxpy(
+      const int dst_id,
+      const TYPE& alpha,
+      const int src1_id,
+      const int src2_id,
+      const bool interior_only = true);
+
+   /**
+    * Add the discrete L1-norm of the data, with the same meaning of
+    * vol_id as in HierarchyDataOpsReal::L1Norm().
+    *
+    * @return Index of the result.
+    */
+   size_t
+   addL1Norm(
+      const int data_id,
+      const int vol_id = -1);
+
+   /**
+    * Add the discrete L2-norm of the data, with the same meaning of
+    * vol_id as in HierarchyDataOpsReal::L2Norm().
+    *
+    * @return Index of the result.
+    */
+   size_t
+   addL2Norm(
+      const int data_id,
+      const int vol_id = -1);
+
+   /**
+    * Add the max-norm of the data, with the same meaning of vol_id as
+    * in HierarchyDataOpsReal::maxNorm().
+    *
+    * @return Index of the result.
+    */
+   size_t
+   addMaxNorm(
+      const int data_id,
+      const int vol_id = -1);
+
+   /**
+    * Add the dot product of the two data arrays, with the same meaning
+    * of vol_id as in HierarchyDataOpsReal::dot().
+    *
+    * @return Index of the result.
+    */
+   size_t
+   addDot(
+      const int data1_id,
+      const int data2_id,
+      const int vol_id = -1);
+
+   /**
+    * Remove all operations and results.
+    */
+   void
+   clear();
+
+   /**
+    * Return the number of operations in the batch.
+    */
+   size_t
+   getNumberOfOperations() const
+   {
+      return d_operations.size();
+   }
+
+   /**
+    * Return the operation at the given position.
+    *
+    * @pre i < getNumberOfOperations()
+    */
+   const Operation&
+   getOperation(
+      size_t i) const
+   {
+      TBOX_ASSERT(i < d_operations.size());
+      return d_operations[i];
+   }
+
+   /**
+    * Return the number of results of the batch.
+    */
+   size_t
+   getNumberOfResults() const
+   {
+      return d_results.size();
+   }
+
+   /**
+    * Return a result of the last computation of the batch.
+    *
+    * @pre i < getNumberOfResults()
+    */
+   double
+   getResult(
+      size_t i) const
+   {
+      TBOX_ASSERT(i < d_results.size());
+      return d_results[i];
+   }
+
+   /**
+    * Set the results from the local contributions of each result and
+    * reduce them across processors.
+    *
+    * This is meant for implementations of computeBatch().  The local
+    * contributions are the sums of absolute values for L1 norms, the
+    * sums of squares for L2 norms, the maxima of absolute values for
+    * max norms and the sums of products for dot products.
+    *
+    * If local_only is true, there is no communication, and the results
+    * are the norms and dot products of the local data.
+    *
+    * @pre local.size() == getNumberOfResults()
+    */
+   void
+   setResults(
+      const std::vector<double>& local,
+      const tbox::SAMRAI_MPI& mpi,
+      bool local_only);
+
+private:
+   // The following are not implemented
+   HierarchyDataOpsBatchReal(
+      const HierarchyDataOpsBatchReal&);
+   HierarchyDataOpsBatchReal&
+   operator = (
+      const HierarchyDataOpsBatchReal&);
+
+   /*
+    * Local contribution of one result in the reduction across
+    * processors, laid out to match MPI_DOUBLE_INT.  is_max selects
+    * whether the contributions are maximized or summed.
+    */
+   struct ReductionValue {
+      double value;
+      int is_max;
+   };
+
+   /*
+    * User-defined reduction operation combining ReductionValues with
+    * max or sum, according to their is_max flags.
+    */
+   static void
+   sumOrMax(
+      void* in,
+      void* inout,
+      int* len,
+      tbox::SAMRAI_MPI::Datatype* datatype);
+
+   /*
+    * Append an operation and, for reductions, a result.
+    */
+   size_t
+   addOperation(
+      OperationType type,
+      int dst_id,
+      int src1_id,
+      int src2_id,
+      int vol_id,
+      const TYPE& alpha,
+      const TYPE& beta,
+      bool interior_only);
+
+   std::vector<Operation> d_operations;
+   std::vector<double> d_results;
+};
+
+}
+}
+
+#include "SAMRAI/math/HierarchyDataOpsBatchReal.C"
+
+#endif
@@ -14,6 +14,7 @@
 #include "SAMRAI/SAMRAI_config.h"
 
 #include "SAMRAI/hier/PatchHierarchy.h"
+#include "SAMRAI/math/HierarchyDataOpsBatchReal.h"
 
 #include <iostream>
 #include <memory>
@@ -464,6 +465,25 @@ public:
       const int denom_id,
       bool local_only = false) const = 0;
 
+   /**
+    * Perform the operations in the batch, in order, and reduce all of
+    * its norms and dot products across processors together.  The
+    * results are retrieved from the batch.  If local_only is true, the
+    * global reductions are not performed (thus each process will get
+    * only local results).
+    *
+    * The default implementation calls the individual operations, which
+    * sweep the hierarchy once per operation, and combines only the
+    * reductions.  Subclasses may override it to perform all operations
+    * in one pass over the patches.
+    *
+    * @see HierarchyDataOpsBatchReal
+    */
+   virtual void
+   computeBatch(
+      HierarchyDataOpsBatchReal<TYPE>& batch,
+      bool local_only = false) const;
+
 private:
    // The following are not implemented
    HierarchyDataOpsReal(
@@ -16,6 +16,7 @@
 #include "SAMRAI/hier/BaseGridGeometry.h"
 #include "SAMRAI/hier/Connector.h"
 #include "SAMRAI/hier/MappingConnector.h"
+#include "SAMRAI/hier/PatchHierarchy.h"
 #include "SAMRAI/hier/PatchLevel.h"
 #include "SAMRAI/hier/ProcessorMapping.h"
 #include "SAMRAI/math/PatchCellDataNormOpsReal.h"
@@ -299,6 +300,39 @@ struct BalanceUtilities {
       int wrk_indx,
       const hier::Box& box);
 
+   /*!
+    * @brief Create a PatchLevel on the boxes of a BoxLevel being
+    * balanced and fill its workload data from the current level of the
+    * hierarchy.
+    *
+    * Load balancers use the returned level to weight the boxes they
+    * balance by the workload of the level those boxes replace.  The
+    * Connectors between the new level and the current level are found
+    * by bridging through the reference level, and are cached on both.
+    *
+    * @return  The workload level, with workload data allocated and filled.
+    *
+    * @param[in] balance_box_level  Boxes being balanced.
+    * @param[in] balance_to_reference  Connector from balance_box_level
+    *                                  to the reference BoxLevel, with
+    *                                  its transpose.
+    * @param[in] hierarchy  Hierarchy whose level level_number holds the
+    *                       current workload data.
+    * @param[in] level_number  Number of the level being balanced.
+    * @param[in] wrk_indx  Patch data identifier for cell-centered work
+    *                      data.
+    *
+    * @pre hierarchy->getNumberOfLevels() > level_number
+    * @pre wrk_indx >= 0
+    */
+   static std::shared_ptr<hier::PatchLevel>
+   createWorkloadLevel(
+      const hier::BoxLevel& balance_box_level,
+      const hier::Connector& balance_to_reference,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      int level_number,
+      int wrk_indx);
+
    /*!
     * @brief Compute total workload in region of argument box based on patch
     * data defined by given integer index, while also associating weights with
@@ -101,6 +101,12 @@ private:
     */
    static const int BAD_INTEGER;
 
+   /*
+    * Number of inflection cut candidates at which cutAtInflection()
+    * splits the search among threads.
+    */
+   static const int s_min_parallel_cut_candidates;
+
    /*!
     * @brief Shorthand for std::vector<int> for internal use.
     */
@@ -369,6 +375,22 @@ private:
       int& inflection,
       const tbox::Dimension::dir_t dim);
 
+   /*!
+    * @brief Whether cut point a is preferred over cut point b having
+    * the same inflection, by being closer to mid or, if as close,
+    * lower.
+    */
+   static bool
+   isPreferredCut(
+      int a,
+      int b,
+      int mid)
+   {
+      const int dist_a = a < mid ? mid - a : a - mid;
+      const int dist_b = b < mid ? mid - b : b - mid;
+      return dist_a < dist_b || (dist_a == dist_b && a < b);
+   }
+
    int
    getHistogramBufferSize(
       const hier::Box& box) const
@@ -0,0 +1,105 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   Cell tag data communicated one bit per cell.
+ *
+ ************************************************************************/
+
+#ifndef included_mesh_BitPackedTagData
+#define included_mesh_BitPackedTagData
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/pdat/CellData.h"
+
+namespace SAMRAI {
+namespace mesh {
+
+/*!
+ * @brief Class BitPackedTagData is integer cell data holding only the
+ * values 0 and 1, which it communicates with one bit per cell instead
+ * of one integer.
+ *
+ * The data is stored, accessed and copied exactly as pdat::CellData<int>,
+ * so code that casts it to pdat::CellData<int> works unchanged.  Only
+ * the message stream methods differ.  They are used by the
+ * GriddingAlgorithm to exchange the buffered tags on a level, where
+ * the ghost region exchanged for a large tag buffer is a large part of
+ * the message traffic of a regrid.
+ *
+ * Overlaps with a rotation are streamed as pdat::CellData<int>.  The
+ * sender and receiver see the same overlap, so they agree on the form.
+ *
+ * @see BitPackedTagDataFactory
+ * @see GriddingAlgorithm
+ */
+
+class BitPackedTagData:public pdat::CellData<int>
+{
+public:
+   /*!
+    * @brief Construct the data with the given box, depth and ghost width.
+    *
+    * @pre depth > 0
+    * @pre ghosts.min() >= 0
+    */
+   BitPackedTagData(
+      const hier::Box& box,
+      int depth,
+      const hier::IntVector& ghosts);
+
+   /*!
+    * @brief The virtual destructor.
+    */
+   virtual ~BitPackedTagData();
+
+   /*!
+    * @brief Return the number of bytes needed to stream the data in the
+    * overlap, one bit per value rounded up to whole bytes.
+    *
+    * @pre dynamic_cast<const pdat::CellOverlap *>(&overlap) != 0
+    */
+   virtual size_t
+   getDataStreamSize(
+      const hier::BoxOverlap& overlap) const;
+
+   /*!
+    * @brief Pack the data in the overlap into the stream, one bit per
+    * value.
+    *
+    * @pre dynamic_cast<const pdat::CellOverlap *>(&overlap) != 0
+    * @pre Every value in the overlap is 0 or 1.
+    */
+   virtual void
+   packStream(
+      tbox::MessageStream& stream,
+      const hier::BoxOverlap& overlap) const;
+
+   /*!
+    * @brief Unpack data packed by packStream() into the overlap.
+    *
+    * @pre dynamic_cast<const pdat::CellOverlap *>(&overlap) != 0
+    */
+   virtual void
+   unpackStream(
+      tbox::MessageStream& stream,
+      const hier::BoxOverlap& overlap);
+
+private:
+   // Unimplemented copy constructor.
+   BitPackedTagData(
+      const BitPackedTagData&);
+
+   // Unimplemented assignment operator.
+   BitPackedTagData&
+   operator = (
+      const BitPackedTagData&);
+
+};
+
+}
+}
+
+#endif
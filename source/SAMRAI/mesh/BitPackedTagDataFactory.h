@@ -0,0 +1,85 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   Factory for cell tag data communicated one bit per cell.
+ *
+ ************************************************************************/
+
+#ifndef included_mesh_BitPackedTagDataFactory
+#define included_mesh_BitPackedTagDataFactory
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/pdat/CellDataFactory.h"
+
+#include <memory>
+
+namespace SAMRAI {
+namespace mesh {
+
+/*!
+ * @brief Class BitPackedTagDataFactory is a pdat::CellDataFactory<int>
+ * that allocates BitPackedTagData.
+ *
+ * Set it as the factory of a pdat::CellVariable<int> to have the
+ * variable's data communicated one bit per cell.
+ *
+ * @see BitPackedTagData
+ */
+
+class BitPackedTagDataFactory:public pdat::CellDataFactory<int>
+{
+public:
+   /*!
+    * @brief Construct the factory with the given depth and default ghost
+    * cell width.
+    *
+    * @pre depth > 0
+    * @pre ghosts.min() >= 0
+    */
+   BitPackedTagDataFactory(
+      int depth,
+      const hier::IntVector& ghosts);
+
+   /*!
+    * @brief The virtual destructor.
+    */
+   virtual ~BitPackedTagDataFactory();
+
+   /*!
+    * @brief Return a BitPackedTagDataFactory with the same depth and the
+    * given ghost cell width.
+    *
+    * @pre getDim() == ghosts.getDim()
+    */
+   virtual std::shared_ptr<hier::PatchDataFactory>
+   cloneFactory(
+      const hier::IntVector& ghosts);
+
+   /*!
+    * @brief Allocate a BitPackedTagData on the patch.
+    *
+    * @pre getDim() == patch.getDim()
+    */
+   virtual std::shared_ptr<hier::PatchData>
+   allocate(
+      const hier::Patch& patch) const;
+
+private:
+   // Unimplemented copy constructor.
+   BitPackedTagDataFactory(
+      const BitPackedTagDataFactory&);
+
+   // Unimplemented assignment operator.
+   BitPackedTagDataFactory&
+   operator = (
+      const BitPackedTagDataFactory&);
+
+};
+
+}
+}
+
+#endif
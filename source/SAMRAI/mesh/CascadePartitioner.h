@@ -79,6 +79,19 @@ namespace mesh {
  *   load balancing always uses the voucher method regardless of this
  *   parameter's value.
  *
+ *   - \b incremental_rebalance
+ *   Boolean parameter to turn on incremental (diffusive) rebalancing of
+ *   levels that already exist in the hierarchy.  The boxes of the new
+ *   level are first given to the processes owning most of the cells
+ *   they cover on the current level.  The cascade then moves only the
+ *   work needed to bring the groups within flexible_load_tolerance of
+ *   their ideal loads, instead of balancing them as closely as it can.
+ *   This reduces data migration during regridding at the cost of a
+ *   larger imbalance.  New levels are balanced as usual.  If
+ *   DEV_report_load_balance is also on, the number of cells that change
+ *   owners is counted, at the cost of an extra Connector bridge per
+ *   balance, and reported by printStatistics().
+ *
  * <b> Details: </b> <br>
  * <table>
  *   <tr>
@@ -121,6 +134,14 @@ namespace mesh {
  *     <td>opt</td>
  *     <td>Not written to restart. Value in input db used.</td>
  *   </tr>
+ *   <tr>
+ *     <td>incremental_rebalance</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE or FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
  * </table>
  *
  * @internal The following are developer inputs.  Defaults listed
@@ -360,6 +381,46 @@ private:
    void
    updateConnectors() const;
 
+   /*!
+    * @brief Whether the level being balanced can be rebalanced
+    * incrementally from the current level of the hierarchy.
+    */
+   bool
+   canRebalanceIncrementally(
+      const hier::Connector* balance_to_reference,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      int level_number) const;
+
+   /*!
+    * @brief Bridge balance--->reference--->current to get the overlaps
+    * of the balance boxes with the current level of the hierarchy.
+    */
+   std::shared_ptr<hier::Connector>
+   bridgeToCurrentLevel(
+      const hier::Connector& balance_to_reference,
+      const hier::PatchHierarchy& hierarchy,
+      int level_number) const;
+
+   /*!
+    * @brief Give each box of balance_box_level to the process owning
+    * most of the cells it covers on the current level, and update
+    * balance_box_level<==>reference accordingly.
+    */
+   void
+   assignToPreviousOwners(
+      hier::BoxLevel& balance_box_level,
+      hier::Connector* balance_to_reference,
+      const hier::PatchHierarchy& hierarchy,
+      int level_number) const;
+
+   /*!
+    * @brief Count the local cells of balance_box_level that were
+    * owned by another process on the current level.
+    */
+   double
+   countMigratedCells(
+      const hier::Connector& balance_to_current) const;
+
    /*!
     * @brief Determine globally reduced work parameters.
     */
@@ -453,6 +514,13 @@ private:
     */
    bool d_use_vouchers;
 
+   /*!
+    * @brief Whether to rebalance existing levels incrementally.
+    *
+    * See input parameter "incremental_rebalance".
+    */
+   bool d_incremental_rebalance;
+
    /*!
     * @brief Metadata operations with timers set according to this object.
     */
@@ -473,6 +541,8 @@ private:
    mutable LoadType d_local_work_max;
    mutable LoadType d_min_load;
    mutable size_t d_num_initial_owners;
+   //! @brief Imbalance allowed in incremental mode, zero otherwise.
+   mutable LoadType d_incremental_tol;
 
    //! @brief Local load subject to change.
    mutable TransitLoad* d_local_load;
@@ -512,6 +582,7 @@ private:
    std::shared_ptr<tbox::Timer> t_communication_wait;
    std::shared_ptr<tbox::Timer> t_distribute_load;
    std::shared_ptr<tbox::Timer> t_update_connectors;
+   std::shared_ptr<tbox::Timer> t_assign_to_previous_owners;
    std::shared_ptr<tbox::Timer> t_global_work_reduction;
    std::shared_ptr<tbox::Timer> t_combine_children;
    std::shared_ptr<tbox::Timer> t_balance_children;
@@ -529,6 +600,8 @@ private:
 
    mutable std::vector<double> d_load_stat;
    mutable std::vector<int> d_box_count_stat;
+   mutable std::vector<double> d_migrated_cell_stat;
+   mutable std::vector<double> d_level_cell_stat;
 
 };
 
@@ -14,8 +14,10 @@
 #include "SAMRAI/SAMRAI_config.h"
 #include "SAMRAI/mesh/BalanceUtilities.h"
 #include "SAMRAI/mesh/LoadBalanceStrategy.h"
+#include "SAMRAI/mesh/MultilevelGraphPartitioner.h"
 #include "SAMRAI/hier/MappingConnector.h"
 #include "SAMRAI/hier/MappingConnectorAlgorithm.h"
+#include "SAMRAI/hier/PatchLevel.h"
 #include "SAMRAI/tbox/AsyncCommPeer.h"
 #include "SAMRAI/tbox/AsyncCommStage.h"
 #include "SAMRAI/tbox/CommGraphWriter.h"
@@ -36,22 +38,46 @@ namespace SAMRAI {
 namespace mesh {
 
 /*!
- * @brief A graph-based load balance using PT-Scotch to partition patches
- * on a level.
+ * @brief A graph-based load balancer partitioning the patches on a level
+ * to minimize the ghost data communicated between processors.
  *
  * This class load balances by treating input boxes as weighted nodes on a
- * graph. The PT-Scotch graph partitioning library is used to distribute these
- * nodes across all the processors.
+ * graph, connected by edges between neighboring boxes.  The graph is
+ * partitioned across all the processors, either by the built-in
+ * MultilevelGraphPartitioner or by the PT-Scotch graph partitioning
+ * library, when SAMRAI is configured with it.
  *
- * If SAMRAI is not configured with PT-Scotch, this class will still compile,
- * but the load balancing calls will effectively be no-ops.
+ * With the built-in partitioner, each node is weighted by the workload
+ * of its box, computed from the workload patch data if it is set with
+ * setWorkloadPatchDataIndex() or from the number of cells otherwise.
+ * Each edge is weighted by the ghost overlap of its two boxes: the number
+ * of cells of each box within the width of the level's self Connector of
+ * the other.  The partition thus approximately minimizes the volume of
+ * ghost data exchanged between processors.  With PT-Scotch, only
+ * uniform load balancing is supported.
  *
  * This class is primarily intended to be used as a load balancing option
  * within the TilePartitioner class after clustering has been executed by
  * the TileClustering class, though it is not required to be used in that
  * context.
  *
- * Currently, only uniform load balancing is supported.
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *   - \b graph_partitioner
+ *   Graph partitioner to use: "MULTILEVEL" for the built-in multilevel
+ *   partitioner or "PTSCOTCH" for the PT-Scotch library.  The default is
+ *   "PTSCOTCH" if SAMRAI is configured with PT-Scotch and "MULTILEVEL"
+ *   otherwise.
+ *
+ *   - \b imbalance_tolerance
+ *   Fractional imbalance allowed by the built-in partitioner, relative to
+ *   the average workload per processor.  Larger values give the
+ *   partitioner more freedom to reduce the ghost data exchanged.
+ *
+ *   - \b refinement_passes
+ *   Maximum number of passes of the built-in partitioner improving the
+ *   partition on each level of its multilevel graph hierarchy.
  *
  *   - \b target_box_size
  *   The boxes that are recevied by this load balancer as input may be very
@@ -86,6 +112,30 @@ namespace mesh {
  *     <th>behavior on restart</th>
  *   </tr>
  *   <tr>
+ *     <td>graph_partitioner</td>
+ *     <td>string</td>
+ *     <td>"PTSCOTCH" if available, else "MULTILEVEL"</td>
+ *     <td>"MULTILEVEL", "PTSCOTCH"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>imbalance_tolerance</td>
+ *     <td>double</td>
+ *     <td>0.05</td>
+ *     <td>>= 0.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>refinement_passes</td>
+ *     <td>int</td>
+ *     <td>4</td>
+ *     <td>>= 0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
  *     <td>target_box_size</td>
  *     <td>int[]</td>
  *     <td>default computed by internal heuristic</td>
@@ -150,8 +200,7 @@ public:
     * in the hierarchy at the specified descriptor index
     * for estimating the workload on each cell.
     *
-    * Note: This method currently does not affect the results because
-    * this class does not yet support uniform load balancing.
+    * The workload is used only by the built-in graph partitioner.
     *
     * @param data_id
     * Integer value of patch data identifier for workload
@@ -170,7 +219,7 @@ public:
    void
    setWorkloadPatchDataIndex(
       int data_id,
-      int level_number = -1) {}
+      int level_number = -1);
 
    /*!
     * @brief Return true if load balancing procedure for given level
@@ -180,17 +229,13 @@ public:
     */
    bool
    getLoadBalanceDependsOnPatchData(
-      int level_number) const
-   {
-      NULL_USE(level_number);
-      return false;
-   }
+      int level_number) const;
 
    /*!
     * @copydoc LoadBalanceStrategy::loadBalanceBoxLevel()
     *
-    * Note: This implementation does not yet support non-uniform load
-    * balancing.
+    * Note: Non-uniform load balancing is supported only by the built-in
+    * graph partitioner.
     *
     * @pre !balance_to_anchor || balance_to_anchor->hasTranspose()
     * @pre !balance_to_anchor || balance_to_anchor->isTransposeOf(balance_to_anchor->getTranspose())
@@ -323,6 +368,8 @@ private:
       hier::Box d_orig_box;
    };
 
+   static const int s_default_data_id;
+
    static const int GraphLoadBalancer_LOADTAG0 = 1;
    static const int GraphLoadBalancer_LOADTAG1 = 2;
    static const int GraphLoadBalancer_FIRSTDATALEN = 500;
@@ -386,6 +433,56 @@ private:
       hier::Connector& anchor_to_level,
       const hier::MappingConnectorAlgorithm& mca) const;
 
+   /*!
+    * @brief Partition the boxes of the level with PT-Scotch.
+    *
+    * @param[out] partition New owner of each local box, in LocalId order.
+    * @param[in] balance_box_level Level with globally sequential LocalIds.
+    * @param[in] balance_to_balance Self Connector of the level.
+    */
+   void
+   partitionWithPTScotch(
+      std::vector<int>& partition,
+      const hier::BoxLevel& balance_box_level,
+      const hier::Connector& balance_to_balance) const;
+
+   /*!
+    * @brief Partition the boxes of the level with the built-in
+    * MultilevelGraphPartitioner.
+    *
+    * Vertices are weighted by workload and edges by the ghost overlap
+    * of the boxes within the width of balance_to_balance.
+    *
+    * @param[out] partition New owner of each local box, in LocalId order.
+    * @param[in] balance_box_level Level with globally sequential LocalIds.
+    * @param[in] balance_to_balance Self Connector of the level.
+    * @param[in] balance_to_reference Used to get the workload data.
+    * @param[in] hierarchy
+    * @param[in] level_number
+    */
+   void
+   partitionWithMultilevelGraph(
+      std::vector<int>& partition,
+      const hier::BoxLevel& balance_box_level,
+      const hier::Connector& balance_to_balance,
+      const hier::Connector* balance_to_reference,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      int level_number) const;
+
+   /*
+    * Return the workload data id for the given level, or a negative
+    * value for uniform workload.
+    */
+   int
+   getWorkloadDataId(
+      int level_number) const
+   {
+      TBOX_ASSERT(level_number >= 0);
+      return level_number < static_cast<int>(d_workload_data_id.size()) ?
+             d_workload_data_id[level_number] :
+             d_master_workload_data_id;
+   }
+
    /*!
     * @brief Set up the asynchronous communication objects for communicating
     * Boxes from pre-balanced to post-balanced processors.
@@ -401,7 +498,6 @@ private:
     * @param [out] recv_comms Maps ranks for receiving to AsyncCommPeer objects
     * @param [in] old_partition array describing pre-balance partition
     * @param [in] new_partition array describing post-balance partition
-    * @param [in] new_boxes global number of boxes
     * @param [in] my_rank
     * @param [in] mpi
     */
@@ -412,9 +508,8 @@ private:
       std::set<int>& send_procs,
       tbox::AsyncCommStage& recv_stage,
       std::map<int, tbox::AsyncCommPeer<char> *>& recv_comms,
-      const int* old_partition,
-      const int* new_partition,
-      const int num_boxes,
+      const std::vector<int>& old_partition,
+      const std::vector<int>& new_partition,
       const int my_rank,
       const tbox::SAMRAI_MPI& mpi) const;
 
@@ -444,6 +539,31 @@ private:
    mutable hier::IntVector d_bad_interval;
    mutable std::vector<hier::BoxContainer> d_block_domain_boxes;
 
+   /*!
+    * @brief Whether to partition with PT-Scotch instead of the built-in
+    * partitioner.
+    */
+   bool d_use_ptscotch;
+
+   /*!
+    * @brief Built-in graph partitioner.
+    */
+   MultilevelGraphPartitioner d_partitioner;
+
+   /*
+    * Values for workload estimate data used on individual levels when
+    * specified as such.
+    */
+   std::vector<int> d_workload_data_id;
+
+   int d_master_workload_data_id;
+
+   /*!
+    * @brief Level holding the workload data on the boxes being balanced,
+    * set only while balancing with non-uniform workload.
+    */
+   mutable std::shared_ptr<hier::PatchLevel> d_workload_level;
+
 };
 
 }
@@ -74,6 +74,13 @@ namespace mesh {
  *      Levels may also be removed from the
  *      hierarchy if no cells are tagged.
  *
+ *   - @b    makeHierarchyFromRestart()
+ *      This routine makes the levels of a
+ *      hierarchy restored from restart.  When
+ *      the restart was written by a different
+ *      number of processors, it load balances
+ *      the stored levels for the current ones.
+ *
  *
  * These basic AMR operations are used to generate levels in
  * the AMR patch hierarchy at the beginning of a simulation, and regridding
@@ -145,6 +152,39 @@ namespace mesh {
  *      This is an option to save the tags that are used to create a new
  *      fine level in CellData on that level.
  *
+ *   - \b    reuse_unchanged_levels
+ *      whether to keep an existing fine level when regridding produces
+ *      exactly the same boxes for it.  The existing level keeps its
+ *      patch data and cached Connectors, so the bridges and the data
+ *      transfer that replacing it would take are skipped.  The level
+ *      is not reinitialized by the TagAndInitializeStrategy.  Only a
+ *      level identical to the existing one, with the same boxes, BoxIds
+ *      and owners, is kept; a level that changes at all is rebuilt,
+ *      bridged and filled in full.  This is ignored when save_tag_data
+ *      is TRUE.
+ *
+ *   - \b    skip_regrid_if_tags_covered
+ *      whether to keep an existing fine level, without clustering,
+ *      load balancing or transferring data, when all of the cells
+ *      tagged on the next coarser level lie within it.  The tags are
+ *      checked before they are buffered: the tag buffer added when the
+ *      level was made is the room the tagged features have to move
+ *      before they leave the level.  The check takes one pass over the
+ *      tags and one global reduction.  A kept level is not shrunk when
+ *      the tagged region moves away from parts of it, so it may cover
+ *      more cells than the tags require.  A level with no tags under
+ *      it is regridded, and so removed, unless a finer level still
+ *      needs it for nesting.  Levels finer than a kept level are still
+ *      regridded.  This is ignored when save_tag_data is TRUE.
+ *
+ *   - \b    redistribute_on_restart
+ *      whether to make the levels of a hierarchy restored from restart
+ *      by load balancing the stored boxes, as is always done when the
+ *      restart was written by a different number of processors.  See
+ *      makeHierarchyFromRestart().  When FALSE, a restart written by
+ *      the same number of processors restores each processor's own
+ *      patches.
+ *
  * <b> Details: </b> <br>
  * <table>
  *   <tr>
@@ -219,6 +259,30 @@ namespace mesh {
  *     <td>opt</td>
  *     <td>Parameter read from restart db will not be overridden by input db</td>
  *   </tr>
+ *   <tr>
+ *     <td>reuse_unchanged_levels</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
+ *   <tr>
+ *     <td>skip_regrid_if_tags_covered</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
+ *   <tr>
+ *     <td>redistribute_on_restart</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
  * </table>
  *
  * All values read in from a restart database may be overriden by input
@@ -432,6 +496,33 @@ public:
       const std::vector<double>& regrid_start_time = std::vector<double>(),
       const bool level_is_coarsest_to_sync = true);
 
+   /*!
+    * @brief Make the levels of a hierarchy restored from restart.
+    *
+    * This method implements the virtual interface
+    * GriddingAlgorithmStrategy::makeHierarchyFromRestart().
+    *
+    * When the restart was written by the current number of processors
+    * and redistribute_on_restart is FALSE, each processor restores its
+    * own patches with PatchHierarchy::initializeHierarchy().
+    *
+    * Otherwise the boxes of every stored level are read with
+    * PatchHierarchy::getStoredBoxesFromRestart().  From level 0 up, the
+    * stored boxes of each level are spread over the processors and
+    * partitioned by the load balancer for that level, with the gridding
+    * parameters used for making new levels, and the level is made from
+    * the result.  Each processor then reads the patch data of the
+    * stored patches overlapping its new patches with
+    * PatchHierarchy::initializeRedistributedHierarchy().
+    *
+    * As in a restart on the same number of processors, the
+    * TagAndInitializeStrategy does not initialize the levels.
+    *
+    * @pre tbox::RestartManager::getManager()->isFromRestart()
+    */
+   void
+   makeHierarchyFromRestart();
+
    /*!
     * @brief Return pointer to level gridding strategy data member.
     *
@@ -494,12 +585,47 @@ public:
       const std::shared_ptr<tbox::Database>& restart_db) const;
 
    /*
-    * @brief Write out statistics recorded on numbers of cells and patches generated.
+    * @brief Write out statistics recorded on numbers of cells and patches
+    * generated, and the numbers of level regrids performed and skipped.
     */
    void
    printStatistics(
       std::ostream& s = tbox::plog) const;
 
+   /*!
+    * @brief Return the number of times regridding kept an existing
+    * level because the new level would have been the same.
+    *
+    * @see input parameter reuse_unchanged_levels
+    */
+   int
+   getNumberOfReusedLevels() const
+   {
+      return d_num_reused_levels;
+   }
+
+   /*!
+    * @brief Return the number of times regridding kept an existing
+    * level without clustering because the level covered all tags.
+    *
+    * @see input parameter skip_regrid_if_tags_covered
+    */
+   int
+   getNumberOfSkippedRegrids() const
+   {
+      return d_num_skipped_regrids;
+   }
+
+   /*!
+    * @brief Return the number of times a level was regridded by
+    * clustering tags.
+    */
+   int
+   getNumberOfPerformedRegrids() const
+   {
+      return d_num_performed_regrids;
+   }
+
    /*!
     * @brief Get the name of this object.
     */
@@ -1079,6 +1205,25 @@ private:
       const std::shared_ptr<hier::PatchLevel>& tag_level,
       bool preserve_existing_tags) const;
 
+   /*!
+    * @brief Check whether the existing level finer than the tag level
+    * covers all of the unbuffered tags on the tag level and is still
+    * needed.
+    *
+    * The unbuffered tags are the user tags and the tags that keep the
+    * level nesting the level finer than it.  The level is needed if at
+    * least one tag lies under it or if the next finer level exists.
+    *
+    * This is collective over the hierarchy's SAMRAI_MPI.
+    *
+    * @param[in] tag_ln  Tag level number
+    *
+    * @pre d_hierarchy->finerLevelExists(tag_ln)
+    */
+   bool
+   finerLevelCoversTags(
+      const int tag_ln) const;
+
    /*!
     * @brief Check for user tags that violate proper nesting.
     *
@@ -1213,6 +1358,8 @@ private:
     * on new levels after gridding operations are completed.  Note that
     * d_boolean_tag does not use the bool type, but rather its associated
     * integer data is treated as a boolean with only two possible values.
+    * The data of d_buf_tag is BitPackedTagData, which holds only those two
+    * values and communicates them one bit per cell.
     */
    std::shared_ptr<pdat::CellVariable<int> > d_user_tag;
    std::shared_ptr<pdat::CellVariable<int> > d_saved_tag;
@@ -1371,6 +1518,45 @@ private:
     */
    bool d_save_tag_data; 
 
+   /*!
+    * @brief Whether to keep existing levels that regridding does not
+    * change.
+    *
+    * See input parameter reuse_unchanged_levels.
+    */
+   bool d_reuse_unchanged_levels;
+
+   /*!
+    * @brief Number of times an existing level was kept by regridding.
+    */
+   int d_num_reused_levels;
+
+   /*!
+    * @brief Whether to keep existing levels that cover all tags.
+    *
+    * See input parameter skip_regrid_if_tags_covered.
+    */
+   bool d_skip_regrid_if_tags_covered;
+
+   /*!
+    * @brief Whether to load balance the stored levels even for a
+    * restart written by the current number of processors.
+    *
+    * See input parameter redistribute_on_restart.
+    */
+   bool d_redistribute_on_restart;
+
+   /*!
+    * @brief Number of times regridding a level was skipped because the
+    * existing level covered all tags.
+    */
+   int d_num_skipped_regrids;
+
+   /*!
+    * @brief Number of times a level was regridded by clustering tags.
+    */
+   int d_num_performed_regrids;
+
    //@{
    //! @name Used for evaluating peformance.
    bool d_barrier_and_time;
@@ -1384,6 +1570,7 @@ private:
    std::shared_ptr<tbox::Timer> t_load_balance0;
    std::shared_ptr<tbox::Timer> t_bdry_fill_tags_create;
    std::shared_ptr<tbox::Timer> t_make_coarsest;
+   std::shared_ptr<tbox::Timer> t_make_from_restart;
    std::shared_ptr<tbox::Timer> t_make_finer;
    std::shared_ptr<tbox::Timer> t_regrid_all_finer;
    std::shared_ptr<tbox::Timer> t_regrid_finer_do_tagging_before;
@@ -1402,6 +1589,7 @@ private:
    std::shared_ptr<tbox::Timer> t_bridge_new_to_finer;
    std::shared_ptr<tbox::Timer> t_bridge_new_to_old;
    std::shared_ptr<tbox::Timer> t_find_boxes_containing_tags;
+   std::shared_ptr<tbox::Timer> t_check_tags_covered;
    std::shared_ptr<tbox::Timer> t_fix_zero_width_clustering;
    std::shared_ptr<tbox::Timer> t_enforce_proper_nesting;
    std::shared_ptr<tbox::Timer> t_compute_proper_nesting_data;
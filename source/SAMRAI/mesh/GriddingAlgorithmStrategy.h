@@ -145,6 +145,22 @@ public:
       const std::vector<double>& regrid_start_time = std::vector<double>(),
       const bool level_is_coarsest_to_sync = true) = 0;
 
+   /*!
+    * @brief Make the levels of a hierarchy restored from restart.
+    *
+    * This takes the place of makeCoarsestLevel() and makeFinerLevel()
+    * when a simulation starts from restart.  It should make every level
+    * written to restart, with the patch data written for it, including
+    * when the restart was written by a different number of processors.
+    *
+    * The default implementation calls initializeHierarchy() on the
+    * hierarchy returned by getPatchHierarchy(), which restores the
+    * levels as written and only works on the number of processors that
+    * wrote the restart.
+    */
+   virtual void
+   makeHierarchyFromRestart();
+
    /*!
     * @brief Return pointer to level gridding strategy data member.
     */
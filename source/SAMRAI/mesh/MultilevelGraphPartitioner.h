@@ -0,0 +1,273 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   Parallel multilevel partitioner for distributed graphs.
+ *
+ ************************************************************************/
+
+#ifndef included_mesh_MultilevelGraphPartitioner
+#define included_mesh_MultilevelGraphPartitioner
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+
+#include <map>
+#include <vector>
+
+namespace SAMRAI {
+namespace mesh {
+
+/*!
+ * @brief Parallel multilevel partitioner for weighted graphs distributed
+ * across the processes of an MPI communicator.
+ *
+ * The graph is given in distributed compressed sparse row form, as in
+ * ParMETIS: process p owns the vertices with global indices
+ * vtxdist[p] through vtxdist[p+1]-1, and the neighbors of its local
+ * vertex v are adjncy[xadj[v]] through adjncy[xadj[v+1]-1], given by
+ * global index, with edge weights in adjwgt.
+ *
+ * The partitioner works in three phases:
+ *
+ * -# Coarsening.  The graph is repeatedly contracted by heavy-edge
+ *    matching until it has few vertices per part.  Matching is done
+ *    only between vertices on the same process, so coarsening needs
+ *    communication only to learn the coarse indices of remote neighbors.
+ * -# Initial partitioning.  The coarsest graph is gathered to every
+ *    process, and each process computes the same partition by recursive
+ *    bisection with greedy graph growing.
+ * -# Uncoarsening.  The partition is projected back through the levels
+ *    and improved on each level by a parallel greedy refinement that
+ *    moves boundary vertices to reduce the weight of cut edges without
+ *    exceeding the balance tolerance.
+ *
+ * The refinement alternates between passes moving vertices only to
+ * higher-numbered parts and passes moving them only to lower-numbered
+ * parts, so two neighbors on different processes never swap parts in
+ * the same pass.  Moves into a part are granted in proportion to the
+ * weight each process asks to move into it, so concurrent moves cannot
+ * overload the part.
+ *
+ * The partition is deterministic: it is the same from run to run for
+ * the same distributed graph.
+ */
+
+class MultilevelGraphPartitioner
+{
+public:
+   /*!
+    * @brief Constructor sets the default parameters.
+    */
+   MultilevelGraphPartitioner();
+
+   /*!
+    * @brief Destructor.
+    */
+   ~MultilevelGraphPartitioner();
+
+   /*!
+    * @brief Set the allowed imbalance, as a fraction of the average
+    * part weight.  The default is 0.05.
+    *
+    * @pre tolerance >= 0.0
+    */
+   void
+   setImbalanceTolerance(
+      double tolerance);
+
+   /*!
+    * @brief Set the maximum number of refinement passes on each level
+    * of the multilevel hierarchy.  The default is 4.
+    *
+    * @pre num_passes >= 0
+    */
+   void
+   setNumberOfRefinementPasses(
+      int num_passes);
+
+   /*!
+    * @brief Set the number of vertices per part below which the graph
+    * is not coarsened further.  The default is 8.
+    *
+    * @pre num_vertices > 0
+    */
+   void
+   setCoarsestVerticesPerPart(
+      int num_vertices);
+
+   /*!
+    * @brief Partition a distributed graph.
+    *
+    * This method is collective over mpi.  The adjacency should be
+    * symmetric with symmetric weights; edges to the vertex itself are
+    * ignored.
+    *
+    * @param[out] part Part of each local vertex, in [0,nparts).
+    * @param[in] vtxdist Global index of the first vertex on each process,
+    *            with vtxdist[mpi.getSize()] the global number of vertices.
+    * @param[in] xadj Offsets of the local adjacency lists.
+    * @param[in] adjncy Global indices of the neighbors.
+    * @param[in] vwgt Vertex weights.
+    * @param[in] adjwgt Edge weights.
+    * @param[in] nparts Number of parts.
+    * @param[in] mpi
+    *
+    * @pre vtxdist.size() == mpi.getSize() + 1
+    * @pre xadj.size() == vtxdist[mpi.getRank()+1] - vtxdist[mpi.getRank()] + 1
+    * @pre adjncy.size() == xadj.back() && adjwgt.size() == xadj.back()
+    * @pre nparts > 0
+    */
+   void
+   partition(
+      std::vector<int>& part,
+      const std::vector<int>& vtxdist,
+      const std::vector<int>& xadj,
+      const std::vector<int>& adjncy,
+      const std::vector<double>& vwgt,
+      const std::vector<double>& adjwgt,
+      int nparts,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+private:
+   // The following are not implemented:
+   MultilevelGraphPartitioner(
+      const MultilevelGraphPartitioner&);
+   MultilevelGraphPartitioner&
+   operator = (
+      const MultilevelGraphPartitioner&);
+
+   /*
+    * One level of the multilevel hierarchy, with the communication
+    * pattern for exchanging values of vertices adjacent to other
+    * processes.
+    */
+   struct Graph {
+      std::vector<int> vtxdist;
+      std::vector<int> xadj;
+      std::vector<int> adjncy;
+      std::vector<double> vwgt;
+      std::vector<double> adjwgt;
+
+      //! @brief Global index of the first local vertex.
+      int first_vertex;
+      //! @brief Local vertices to send to each process.
+      std::map<int, std::vector<int> > send_vertices;
+      //! @brief Processes sending values of their vertices.
+      std::vector<int> recv_ranks;
+
+      int
+      getNumberOfLocalVertices() const
+      {
+         return static_cast<int>(xadj.size()) - 1;
+      }
+
+      bool
+      isLocal(
+         int vertex) const
+      {
+         return vertex >= first_vertex &&
+                vertex < first_vertex + getNumberOfLocalVertices();
+      }
+   };
+
+   static const int MultilevelGraphPartitioner_HANDSHAKETAG = 2900;
+   static const int MultilevelGraphPartitioner_EXCHANGETAG = 2901;
+
+   /*
+    * Set up the send lists and receiving processes of the graph.
+    */
+   void
+   setUpCommunication(
+      Graph& graph,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+   /*
+    * Send the values of local vertices to the processes owning their
+    * neighbors, and receive the values of remote neighbors by global
+    * index.
+    */
+   void
+   exchangeBoundaryValues(
+      std::map<int, int>& remote_values,
+      const Graph& graph,
+      const std::vector<int>& values,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+   /*
+    * Contract the fine graph by heavy-edge matching of local vertices.
+    * cmap gets the global index of the coarse vertex of each local
+    * fine vertex.  Return false if no vertex was matched anywhere.
+    */
+   bool
+   coarsen(
+      Graph& coarse,
+      std::vector<int>& cmap,
+      const Graph& fine,
+      double max_vertex_weight,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+   /*
+    * Partition the coarsest graph by gathering it to all processes and
+    * doing the same recursive bisection everywhere.
+    */
+   void
+   computeInitialPartition(
+      std::vector<int>& part,
+      const Graph& graph,
+      int nparts,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+   /*
+    * Split the given vertices of a serial graph into parts
+    * [first_part,first_part+nparts) by recursive bisection.
+    */
+   void
+   bisect(
+      std::vector<int>& part,
+      std::vector<char>& in_subgraph,
+      const std::vector<int>& vertices,
+      const std::vector<int>& xadj,
+      const std::vector<int>& adjncy,
+      const std::vector<double>& vwgt,
+      const std::vector<double>& adjwgt,
+      int first_part,
+      int nparts) const;
+
+   /*
+    * Improve the partition of the graph by greedy moves of boundary
+    * vertices.
+    */
+   void
+   refinePartition(
+      std::vector<int>& part,
+      const Graph& graph,
+      int nparts,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+   /*
+    * Compute the connectivity of a local vertex to each adjacent part,
+    * in order of part number.
+    */
+   void
+   computeConnectivity(
+      std::vector<std::pair<int, double> >& connectivity,
+      const Graph& graph,
+      int vertex,
+      const std::vector<int>& part,
+      const std::map<int, int>& remote_part) const;
+
+   double d_imbalance_tolerance;
+
+   int d_num_refinement_passes;
+
+   int d_coarsest_vertices_per_part;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,586 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   Load balancer using a space-filling curve.
+ *
+ ************************************************************************/
+
+#ifndef included_mesh_SpaceFillingCurveLoadBalancer
+#define included_mesh_SpaceFillingCurveLoadBalancer
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/hier/MappingConnectorAlgorithm.h"
+#include "SAMRAI/mesh/BoxInTransit.h"
+#include "SAMRAI/mesh/LoadBalanceStrategy.h"
+#include "SAMRAI/mesh/PartitioningParams.h"
+#include "SAMRAI/mesh/SpatialKey.h"
+#include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/RankGroup.h"
+#include "SAMRAI/tbox/Timer.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include <iostream>
+#include <vector>
+#include <memory>
+
+namespace SAMRAI {
+namespace mesh {
+
+/*!
+ * @brief Provides load balancing routines for AMR hierarchy by
+ * implementing the LoadBalanceStrategy using a space-filling curve.
+ *
+ * The boxes of the level are chopped into pieces of about a target
+ * size.  The pieces are ordered along a Hilbert (or Morton) curve
+ * through the centers of the pieces, with the pieces of each block of
+ * a multiblock geometry kept together in block order.  The curve is
+ * then cut into consecutive segments of equal load, one per process.
+ * Pieces of the same original box that land on the same process are
+ * coalesced again, so boxes that are not moved come back unchanged.
+ *
+ * The ordering is a parallel sample sort.  Each process contributes a
+ * few regular samples of its locally sorted pieces to process 0, which
+ * picks splitters and broadcasts them.  The pieces are sent to the
+ * process owning their bucket, sorted there, and a prefix sum of the
+ * bucket loads gives each piece its position on the curve and thus its
+ * final owner.  Apart from the sample gather, whose size is
+ * proportional to the number of processes, and scalar reductions that
+ * detect when all pieces have been received, all communication is
+ * point-to-point between processes that exchange pieces.
+ *
+ * Because the partition depends only on the geometry of the pieces and
+ * their loads, small changes in the level move little work between
+ * processes, and the segments of a Hilbert curve are compact, giving
+ * small ghost-cell surfaces.
+ *
+ * This class can be used for both uniform or non-uniform load balancing.
+ * To enable non-uniform load balancing, a call must be made to the method
+ * setWorkloadPatchDataIndex to give this object a patch data id for
+ * cell-centered workload data that must be set on the hierarchy outside of
+ * this class.
+ *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *
+ *   - \b curve_type
+ *   The space-filling curve used to order the pieces, "HILBERT" or
+ *   "MORTON".
+ *
+ *   - \b target_box_size
+ *   Size of the pieces the boxes are chopped into before ordering them.
+ *   If not given, a size is chosen so that each process gets about
+ *   pieces_per_process pieces.  The size is limited by the minimum and
+ *   maximum box sizes.
+ *
+ *   - \b pieces_per_process
+ *   Number of pieces per process aimed for when target_box_size is not
+ *   given.  More pieces give better balance but more boxes.
+ *
+ *   - \b samples_per_process
+ *   Number of pieces each process contributes to choose the sample sort
+ *   splitters.
+ *
+ *   - \b tile_size
+ *   Tile size when using tile mode.  Tile mode restricts box cuts
+ *   to tile boundaries.  Default is 1, which is equivalent to no restriction.
+ *
+ *   - \b coalesce_boxes
+ *   Whether to coalesce pieces of the same original box assigned to the
+ *   same process.
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>curve_type</td>
+ *     <td>string</td>
+ *     <td>"HILBERT"</td>
+ *     <td>"HILBERT", "MORTON"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>target_box_size</td>
+ *     <td>int[]</td>
+ *     <td>none</td>
+ *     <td>all values > 0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>pieces_per_process</td>
+ *     <td>int</td>
+ *     <td>8</td>
+ *     <td> >= 1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>samples_per_process</td>
+ *     <td>int</td>
+ *     <td>16</td>
+ *     <td> >= 1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>tile_size</td>
+ *     <td>IntVector</td>
+ *     <td>1</td>
+ *     <td>1-</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>coalesce_boxes</td>
+ *     <td>bool</td>
+ *     <td>TRUE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
+ * @see LoadBalanceStrategy
+ * @see SpatialKey
+ */
+
+class SpaceFillingCurveLoadBalancer:
+   public LoadBalanceStrategy
+{
+public:
+   /*!
+    * @brief Initializing constructor sets object state to default or,
+    * if database provided, to parameters in database.
+    *
+    * @param[in] dim
+    *
+    * @param[in] name User-defined identifier used for error reporting
+    * and timer names.
+    *
+    * @param[in] input_db (optional) database pointer providing
+    * parameters from input file.  This pointer may be null indicating
+    * no input is used.
+    *
+    * @pre !name.empty()
+    */
+   SpaceFillingCurveLoadBalancer(
+      const tbox::Dimension& dim,
+      const std::string& name,
+      const std::shared_ptr<tbox::Database>& input_db =
+         std::shared_ptr<tbox::Database>());
+
+   /*!
+    * @brief Virtual destructor releases all internal storage.
+    */
+   virtual ~SpaceFillingCurveLoadBalancer();
+
+   /*!
+    * @brief Set the internal SAMRAI_MPI to a duplicate of the given
+    * SAMRAI_MPI.
+    *
+    * The given SAMRAI_MPI must have a valid communicator.
+    *
+    * The given SAMRAI_MPI is duplicated for private use.  This
+    * requires a global communication, so all processes in the
+    * communicator must call it.  The advantage of a duplicate
+    * communicator is that it ensures the communications for the
+    * object won't accidentally interact with unrelated
+    * communications.
+    *
+    * If the duplicate SAMRAI_MPI it is set, the load balancer will
+    * only balance BoxLevels with congruent SAMRAI_MPI objects and
+    * will use the duplicate SAMRAI_MPI for communications.
+    * Otherwise, the SAMRAI_MPI of the BoxLevel will be used.  The
+    * duplicate MPI communicator is freed when the object is
+    * destructed, or freeMPICommunicator() is called.
+    *
+    * @pre samrai_mpi.getCommunicator() != tbox::SAMRAI_MPI::commNull
+    */
+   void
+   setSAMRAI_MPI(
+      const tbox::SAMRAI_MPI& samrai_mpi);
+
+   /*!
+    * @brief Free the internal MPI communicator, if any has been set.
+    *
+    * This is automatically done by the destructor, if needed.
+    *
+    * @see setSAMRAI_MPI().
+    */
+   void
+   freeMPICommunicator();
+
+   /*!
+    * @copydoc LoadBalanceStrategy::loadBalanceBoxLevel()
+    *
+    * The curve is divided among the ranks of rank_group.
+    *
+    * @pre !balance_to_anchor || balance_to_anchor->hasTranspose()
+    * @pre !balance_to_anchor || balance_to_anchor->isTransposeOf(balance_to_anchor->getTranspose())
+    * @pre (d_dim == balance_box_level.getDim()) &&
+    *      (d_dim == min_size.getDim()) && (d_dim == max_size.getDim()) &&
+    *      (d_dim == domain_box_level.getDim()) &&
+    *      (d_dim == bad_interval.getDim()) && (d_dim == cut_factor.getDim())
+    * @pre hierarchy && (d_dim == hierarchy->getDim())
+    * @pre !d_mpi_is_dupe || (d_mpi.getSize() == balance_box_level.getMPI().getSize())
+    * @pre !d_mpi_is_dupe || (d_mpi.getSize() == balance_box_level.getMPI().getRank())
+    */
+   void
+   loadBalanceBoxLevel(
+      hier::BoxLevel& balance_box_level,
+      hier::Connector* balance_to_anchor,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number,
+      const hier::IntVector& min_size,
+      const hier::IntVector& max_size,
+      const hier::BoxLevel& domain_box_level,
+      const hier::IntVector& bad_interval,
+      const hier::IntVector& cut_factor,
+      const tbox::RankGroup& rank_group = tbox::RankGroup()) const;
+
+   /*!
+    * @brief Write out statistics recorded for the most recent load
+    * balancing result.
+    *
+    * @param[in] output_stream
+    */
+   void
+   printStatistics(
+      std::ostream& output_stream = tbox::plog) const;
+
+   /*!
+    * @brief Get the name of this object.
+    */
+   const std::string&
+   getObjectName() const
+   {
+      return d_object_name;
+   }
+
+   /*!
+    * @brief Configure the load balancer to use the data stored
+    * in the hierarchy at the specified descriptor index
+    * for estimating the workload on each cell.
+    *
+    * @param data_id
+    * Integer value of patch data identifier for workload
+    * estimate on each cell.  An invalid value (i.e., < 0)
+    * indicates that a spatially-uniform work estimate
+    * will be used.  The default value is -1 (undefined)
+    * implying the uniform work estimate.
+    *
+    * @param level_number
+    * Optional integer number for level on which data id
+    * is used.  If no value is given, the data will be
+    * used for all levels.
+    *
+    * @pre hier::VariableDatabase::getDatabase()->getPatchDescriptor()->getPatchDataFactory(data_id) is actually a  std::shared_ptr<pdat::CellDataFactory<double> >
+    */
+   void
+   setWorkloadPatchDataIndex(
+      int data_id,
+      int level_number = -1);
+
+   /*!
+    * @brief Return true if load balancing procedure for given level
+    * depends on patch data on mesh; otherwise return false.
+    *
+    * @param[in] level_number  Integer patch level number.
+    */
+   bool
+   getLoadBalanceDependsOnPatchData(
+      int level_number) const;
+
+private:
+   /*
+    * Static integer constants.  Tags are for isolating messages
+    * from different phases of the algorithm.
+    */
+   static const int SpaceFillingCurveLoadBalancer_SORTTAG = 1;
+   static const int SpaceFillingCurveLoadBalancer_ASSIGNTAG = 2;
+
+   /*
+    * Position on the curve: the block, then the key within the block.
+    */
+   struct CurvePosition {
+      hier::BlockId::block_t d_block;
+      SpatialKey d_key;
+      bool operator < (const CurvePosition& other) const {
+         return d_block < other.d_block ||
+                (d_block == other.d_block && d_key < other.d_key);
+      }
+   };
+
+   /*
+    * A piece of an original box with its position on the curve.
+    */
+   struct CurvePiece {
+      CurvePiece(
+         const BoxInTransit& piece,
+         const CurvePosition& position):
+         d_piece(piece),
+         d_position(position) {
+      }
+      BoxInTransit d_piece;
+      CurvePosition d_position;
+   };
+
+   /*
+    * Order of pieces along the curve.  Pieces at the same position are
+    * ordered by their original boxes, so the ordering is deterministic.
+    */
+   struct CurvePieceLess {
+      bool operator () (const CurvePiece& a, const CurvePiece& b) const {
+         if (a.d_position < b.d_position) return true;
+         if (b.d_position < a.d_position) return false;
+         return a.d_piece.getOrigBox().getBoxId() <
+                b.d_piece.getOrigBox().getBoxId();
+      }
+   };
+
+   // The following are not implemented, but are provided here for
+   // dumb compilers.
+
+   SpaceFillingCurveLoadBalancer(
+      const SpaceFillingCurveLoadBalancer&);
+
+   void
+   operator = (
+      const SpaceFillingCurveLoadBalancer&);
+
+   /*
+    * @brief Check if there is any pending messages for the private
+    * communication and throw an error if there is.
+    */
+   void
+   assertNoMessageForPrivateCommunicator() const;
+
+   /*
+    * Read parameters from input database.
+    */
+   void
+   getFromInput(
+      const std::shared_ptr<tbox::Database>& input_db);
+
+   /*
+    * Utility functions to determine parameter values for level.
+    */
+   int
+   getWorkloadDataId(
+      int level_number) const
+   {
+      TBOX_ASSERT(level_number >= 0);
+      return level_number < static_cast<int>(d_workload_data_id.size()) ?
+             d_workload_data_id[level_number] :
+             d_master_workload_data_id;
+   }
+
+   /*!
+    * @brief Compute the size the boxes are chopped to.
+    */
+   hier::IntVector
+   computeTargetBoxSize(
+      const hier::BoxLevel& balance_box_level,
+      int num_procs) const;
+
+   /*!
+    * @brief Chop the local boxes into pieces of about target_size and
+    * compute their loads and curve positions.
+    */
+   void
+   chopIntoPieces(
+      std::vector<CurvePiece>& pieces,
+      const hier::BoxLevel& balance_box_level,
+      const hier::IntVector& target_size) const;
+
+   /*!
+    * @brief Get the coordinates of a box on the curve, relative to the
+    * lower corner of its block.
+    */
+   void
+   getCurveCoordinates(
+      const hier::Box& box,
+      unsigned int coords[]) const;
+
+   /*!
+    * @brief Compute the curve position from the block and coordinates.
+    */
+   CurvePosition
+   computeCurvePosition(
+      hier::BlockId::block_t block,
+      const unsigned int coords[]) const;
+
+   /*!
+    * @brief Sort the pieces along the curve across all processes.
+    *
+    * On return, the local pieces are sorted and each precedes the
+    * pieces of all higher ranks.
+    */
+   void
+   sortPiecesAlongCurve(
+      std::vector<CurvePiece>& pieces) const;
+
+   /*!
+    * @brief Assign the sorted pieces to the ranks of rank_group by
+    * cutting the curve into segments of equal load, and send them to
+    * their new owners.
+    */
+   void
+   partitionCurve(
+      std::vector<CurvePiece>& pieces,
+      const tbox::RankGroup& rank_group) const;
+
+   /*!
+    * @brief Send pieces to the given ranks and receive the pieces sent
+    * to this process.
+    *
+    * Pieces staying on this process are kept.  Received pieces are
+    * appended, unsorted.
+    */
+   void
+   exchangePieces(
+      std::vector<CurvePiece>& pieces,
+      const std::vector<int>& destinations,
+      int tag) const;
+
+   /*!
+    * @brief Update balance_box_level and the Connectors to the
+    * reference level so the local boxes are the given pieces.
+    */
+   void
+   updateConnectors(
+      hier::BoxLevel& balance_box_level,
+      hier::Connector* balance_to_reference,
+      const std::vector<CurvePiece>& pieces) const;
+
+   /*!
+    * @brief Set up timers for the object.
+    */
+   void
+   setTimers();
+
+   /*
+    * Object dimension.
+    */
+   const tbox::Dimension d_dim;
+
+   /*
+    * String identifier for load balancer object.
+    */
+   std::string d_object_name;
+
+   //! @brief Duplicated communicator object.  See setSAMRAI_MPI().
+   mutable tbox::SAMRAI_MPI d_mpi;
+
+   //! @brief Whether d_mpi is an internal duplicate.  See setSAMRAI_MPI().
+   bool d_mpi_is_dupe;
+
+   /*
+    * Values for workload estimate data used on individual levels when
+    * specified as such.
+    */
+   std::vector<int> d_workload_data_id;
+
+   int d_master_workload_data_id;
+
+   /*!
+    * @brief Whether to order pieces along a Hilbert curve rather than
+    * a Morton curve.  See input parameter "curve_type".
+    */
+   bool d_use_hilbert_curve;
+
+   /*!
+    * @brief Size of pieces, if given.  See input parameter
+    * "target_box_size".
+    */
+   hier::IntVector d_target_box_size;
+
+   //! @brief See input parameter "pieces_per_process".
+   int d_pieces_per_process;
+
+   //! @brief See input parameter "samples_per_process".
+   int d_samples_per_process;
+
+   /*!
+    * @brief Tile size, when restricting cuts to tile boundaries,
+    * Set to 1 when not restricting.
+    */
+   hier::IntVector d_tile_size;
+
+   //! @brief See input parameter "coalesce_boxes".
+   bool d_coalesce_boxes;
+
+   /*!
+    * @brief Metadata operations with timers set according to this object.
+    */
+   hier::MappingConnectorAlgorithm d_mca;
+
+   /*!
+    * @brief Level holding workload data
+    */
+   mutable std::shared_ptr<hier::PatchLevel> d_workload_level;
+
+   //@{
+   //! @name Shared temporaries, used only when actively partitioning.
+   mutable std::shared_ptr<PartitioningParams> d_pparams;
+
+   //! @brief Lower corner of the bounding box of each block's domain.
+   mutable std::vector<hier::Index> d_block_lower;
+   //@}
+
+   static const int s_default_data_id;
+
+   //@{
+   //! @name Used for evaluating peformance.
+
+   /*!
+    * @brief Whether to immediately report the results of the load
+    * balancing cycles in the log files.
+    */
+   bool d_report_load_balance;
+
+   /*!
+    * @brief See "summarize_map" input parameter.
+    */
+   char d_summarize_map;
+
+   /*
+    * Performance timers.
+    */
+   std::shared_ptr<tbox::Timer> t_load_balance_box_level;
+   std::shared_ptr<tbox::Timer> t_chop_into_pieces;
+   std::shared_ptr<tbox::Timer> t_sort_pieces_along_curve;
+   std::shared_ptr<tbox::Timer> t_partition_curve;
+   std::shared_ptr<tbox::Timer> t_exchange_pieces;
+   std::shared_ptr<tbox::Timer> t_assign_to_local_and_populate_maps;
+   std::shared_ptr<tbox::Timer> t_use_map;
+
+   //@}
+
+   // Extra checks independent of optimization/debug.
+   char d_print_steps;
+   char d_check_connectivity;
+   char d_check_map;
+
+   mutable std::vector<double> d_load_stat;
+   mutable std::vector<int> d_box_count_stat;
+
+};
+
+}
+}
+
+#endif
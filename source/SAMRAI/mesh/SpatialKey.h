@@ -165,6 +165,27 @@ public:
       const unsigned int k = 0,
       const unsigned int level_num = 0);
 
+   /**
+    * Set this key from the index space coordinates and the level number,
+    * ordering the points along a Hilbert space filling curve instead of
+    * the Morton curve of setKey().
+    *
+    * Points adjacent in the Hilbert ordering are always adjacent in
+    * space, so contiguous segments of the curve are more compact than
+    * those of the Morton curve.  Only the first num_dims coordinates are
+    * used.  As with setKey(), the level number is mixed in as the least
+    * significant bit of each group.
+    *
+    * @pre (num_dims >= 1) && (num_dims <= 3)
+    */
+   void
+   setHilbertKey(
+      const int num_dims,
+      const unsigned int i = 0,
+      const unsigned int j = 0,
+      const unsigned int k = 0,
+      const unsigned int level_num = 0);
+
    /**
     * Write a spatial key to an output stream.  The spatial key is
     * output in hex to avoid the binary to decimal conversion of the
@@ -18,6 +18,7 @@
 #include "SAMRAI/hier/BoxContainer.h"
 #include "SAMRAI/hier/Index.h"
 #include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/tbox/AlignedAllocator.h"
 #include "SAMRAI/tbox/Complex.h"
 #include "SAMRAI/tbox/Database.h"
 #include "SAMRAI/tbox/MemoryUtilities.h"
@@ -52,6 +53,11 @@ class SideData;
  * float, and int).  To use this class with other user-defined types,
  * many of these functions will need to be specialized, especially those
  * that deal with message packing and unpacking.
+ *
+ * The array storage is allocated with tbox::AlignedAllocator, so it is
+ * aligned for vector instructions and is recycled through the
+ * tbox::AlignedMemoryPool when patch data is freed and reallocated, as
+ * in regridding.
  */
 
 template<class TYPE>
@@ -669,7 +675,7 @@ private:
    unsigned int d_depth;
    size_t d_offset;
    hier::Box d_box;
-   std::vector<TYPE> d_array;
+   std::vector<TYPE, tbox::AlignedAllocator<TYPE> > d_array;
 };
 
 }
@@ -29,6 +29,14 @@ class ArrayData;
  * and the operation that will be performed on individual array
  * elements in the innermost loop.
  *
+ * The loops decompose the data into runs that are contiguous in both
+ * the source and destination, merging runs across directions when the
+ * operation box spans the arrays.  OP must provide
+ * @code
+ *    void operator () (TYPE* dst, const TYPE* src, size_t n) const;
+ * @endcode
+ * to perform the operation on a run of n elements.
+ *
  * @see ArrayData
  */
 
@@ -105,6 +113,36 @@ public:
       bool src_is_buffer,
       const OP& op);
 private:
+   /*!
+    * Perform operation on the runs of contiguous data starting at dst
+    * and src.
+    *
+    * @param dst  Pointer to the first destination element.
+    * @param src  Pointer to the first source element.
+    * @param run_length  Number of contiguous elements in each run.
+    * @param first_outer  First direction spanned by runs rather than by
+    *                     the run length.
+    * @param ndim  Number of directions.
+    * @param box_w  Number of runs in each direction from first_outer.
+    * @param dst_stride  Distance between runs in the destination in each
+    *                    direction.
+    * @param src_stride  Distance between runs in the source in each
+    *                    direction.
+    * @param op  Operation to perform.
+    */
+   static void
+   doOperationOnRuns(
+      TYPE* dst,
+      const TYPE* src,
+      size_t run_length,
+      int first_outer,
+      int ndim,
+      const int* box_w,
+      const size_t* dst_stride,
+      const size_t* src_stride,
+      const OP& op);
+
+
    // the following are not implemented:
    ArrayDataOperationUtilities();
    ~ArrayDataOperationUtilities();
@@ -13,6 +13,9 @@
 
 #include "SAMRAI/SAMRAI_config.h"
 
+#include <algorithm>
+#include <cstddef>
+
 namespace SAMRAI {
 namespace pdat {
 
@@ -43,6 +46,17 @@ public:
       TYPE& vdst,
       const TYPE& vsrc) const;
 
+   /*!
+    * The operator copies n contiguous source values to the
+    * destination.  It is used for runs of contiguous data, which it
+    * processes faster than element-by-element calls.
+    */
+   void
+   operator () (
+      TYPE* vdst,
+      const TYPE* vsrc,
+      size_t n) const;
+
 private:
    CopyOperation(
       const CopyOperation&);              // not implemented
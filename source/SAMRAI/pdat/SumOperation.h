@@ -13,6 +13,8 @@
 
 #include "SAMRAI/SAMRAI_config.h"
 
+#include <cstddef>
+
 namespace SAMRAI {
 namespace pdat {
 
@@ -43,6 +45,17 @@ public:
       TYPE& vdst,
       const TYPE& vsrc) const;
 
+   /*!
+    * The operator adds n contiguous source values to the
+    * destination.  It is used for runs of contiguous data, which it
+    * processes faster than element-by-element calls.
+    */
+   void
+   operator () (
+      TYPE* vdst,
+      const TYPE* vsrc,
+      size_t n) const;
+
 private:
    SumOperation(
       const SumOperation&);             // not implemented
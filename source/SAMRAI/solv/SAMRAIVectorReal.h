@@ -23,6 +23,7 @@
 #include <string>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace solv {
@@ -600,6 +601,25 @@ public:
       const std::shared_ptr<SAMRAIVectorReal<TYPE> >& x,
       bool local_only = false) const;
 
+   /**
+    * Compute the dot products of this vector with each vector in x and
+    * whichever of the L1-, L2- and max-norms of this vector are given
+    * non-null pointers.  Each component is handled in one pass over its
+    * patches through math::HierarchyDataOpsReal::computeBatch(), and all
+    * results are reduced across processors with a single collective
+    * operation instead of one per result.  The results are the same as
+    * those of dot(), L1Norm(), L2Norm() and maxNorm().  dots is
+    * resized to x.size().
+    */
+   void
+   normsAndDots(
+      const std::vector<std::shared_ptr<SAMRAIVectorReal<TYPE> > >& x,
+      std::vector<TYPE>& dots,
+      double* l1_norm = 0,
+      double* l2_norm = 0,
+      double* max_norm = 0,
+      bool local_only = false) const;
+
    /**
     * Return 1 if @f$ \|x_i\| > 0 @f$  and @f$ w_i * x_i \leq 0 @f$ , for any @f$ i @f$  in
     * the set of vector data indices, where @f$ cvol_i > 0 @f$ .  Here, @f$ w_i @f$  is
@@ -0,0 +1,93 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   Standard allocator drawing from the AlignedMemoryPool
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_AlignedAllocator
+#define included_tbox_AlignedAllocator
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/tbox/AlignedMemoryPool.h"
+
+#include <cstddef>
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Allocator for standard containers that takes its memory from
+ * the AlignedMemoryPool.
+ *
+ * Storage allocated through this allocator is aligned to
+ * AlignedMemoryPool::getAlignment() bytes and is recycled by the pool
+ * when freed.  All instances are interchangeable.
+ */
+template<class TYPE>
+class AlignedAllocator
+{
+public:
+   typedef TYPE value_type;
+   typedef TYPE* pointer;
+   typedef const TYPE* const_pointer;
+   typedef TYPE& reference;
+   typedef const TYPE& const_reference;
+   typedef size_t size_type;
+   typedef std::ptrdiff_t difference_type;
+
+   template<class OTHER>
+   struct rebind {
+      typedef AlignedAllocator<OTHER> other;
+   };
+
+   AlignedAllocator()
+   {
+   }
+
+   template<class OTHER>
+   AlignedAllocator(
+      const AlignedAllocator<OTHER>&)
+   {
+   }
+
+   TYPE *
+   allocate(
+      size_t n)
+   {
+      return static_cast<TYPE *>(
+         AlignedMemoryPool::getPool()->allocate(n * sizeof(TYPE)));
+   }
+
+   void
+   deallocate(
+      TYPE* p,
+      size_t n)
+   {
+      AlignedMemoryPool::getPool()->deallocate(p, n * sizeof(TYPE));
+   }
+
+   template<class OTHER>
+   bool
+   operator == (
+      const AlignedAllocator<OTHER>&) const
+   {
+      return true;
+   }
+
+   template<class OTHER>
+   bool
+   operator != (
+      const AlignedAllocator<OTHER>&) const
+   {
+      return false;
+   }
+};
+
+}
+}
+
+#endif
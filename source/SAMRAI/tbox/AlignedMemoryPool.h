@@ -0,0 +1,359 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   Pool of aligned memory blocks for patch data storage
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_AlignedMemoryPool
+#define included_tbox_AlignedMemoryPool
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/tbox/OpenMPUtilities.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Singleton pool of aligned memory blocks, used for the storage
+ * of patch data arrays through AlignedAllocator.
+ *
+ * Regridding frees the data of the patch levels it replaces and
+ * allocates data of similar total size for the new levels.  The pool
+ * keeps freed blocks and gives them to later allocations of similar
+ * size, so repeated regrids reuse memory instead of going to the heap
+ * and faulting in new pages.
+ *
+ * Blocks are aligned to getAlignment() bytes.  Requested sizes are
+ * rounded up to size classes spaced at most 1/8 of the size apart, so
+ * a block is reused for requests up to 12.5% smaller than itself.
+ *
+ * The pool is thread-safe.  It keeps statistics, which can be written
+ * with printStatistics().
+ *
+ * <b> Input Parameters </b>
+ *
+ * The pool reads the "AlignedMemoryPool" database of the input file,
+ * when it exists, at the first allocation after the input file has
+ * been read.  The check is made under the pool's lock, so threads
+ * allocating concurrently see consistent settings.
+ *
+ * <b> Definitions: </b>
+ *    - \b enable_pooling
+ *       Whether freed blocks are kept for reuse.  If false, blocks are
+ *       freed to the heap immediately.
+ *
+ *    - \b max_megabytes_held
+ *       Limit on the memory held by the pool and not in use.  Blocks
+ *       freed beyond this limit go back to the heap, so that memory
+ *       freed after a spike in use, such as a regrid, is returned to
+ *       the system.  The default is getDefaultMaxBytesHeld().  A
+ *       negative value means no limit.
+ *
+ *    - \b use_huge_pages
+ *       Whether to align blocks of at least getHugePageSize() bytes to
+ *       the huge page size and advise the operating system to back them
+ *       with huge pages.  This has an effect only on Linux.
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>enable_pooling</td>
+ *     <td>bool</td>
+ *     <td>TRUE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>max_megabytes_held</td>
+ *     <td>int</td>
+ *     <td>256</td>
+ *     <td>any int</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>use_huge_pages</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.</td>
+ *   </tr>
+ * </table>
+ *
+ * Blocks held by the pool beyond the limit are freed when given back.
+ * The others are freed by releaseUnusedBlocks() and at SAMRAI
+ * finalization.
+ */
+class AlignedMemoryPool
+{
+public:
+   /*!
+    * @brief Get the pool.
+    */
+   static AlignedMemoryPool *
+   getPool();
+
+   /*!
+    * @brief Get a block of at least num_bytes bytes, aligned to
+    * getAlignment() bytes.
+    *
+    * The contents of the block are undefined.
+    *
+    * @param[in] num_bytes
+    *
+    * @return The block, or 0 if num_bytes is zero.
+    */
+   void *
+   allocate(
+      size_t num_bytes);
+
+   /*!
+    * @brief Give a block from allocate() back to the pool.
+    *
+    * @param[in] block  The block.  Nothing is done if it is 0.
+    * @param[in] num_bytes  The size given to allocate() for the block.
+    */
+   void
+   deallocate(
+      void* block,
+      size_t num_bytes);
+
+   /*!
+    * @brief Return the alignment of the blocks, in bytes.
+    */
+   static size_t
+   getAlignment()
+   {
+      return s_alignment;
+   }
+
+   /*!
+    * @brief Return the size above which blocks may be backed by huge
+    * pages.
+    */
+   static size_t
+   getHugePageSize()
+   {
+      return s_huge_page_size;
+   }
+
+   /*!
+    * @brief Set whether freed blocks are kept for reuse.
+    *
+    * Disabling pooling frees the blocks held by the pool.
+    */
+   void
+   setPoolingEnabled(
+      bool enabled);
+
+   /*!
+    * @brief Return the default limit on the number of bytes held by
+    * the pool and not in use.
+    */
+   static size_t
+   getDefaultMaxBytesHeld()
+   {
+      return s_default_max_bytes_held;
+   }
+
+   /*!
+    * @brief Set the limit on the number of bytes held by the pool and
+    * not in use.
+    *
+    * Blocks held beyond the new limit are not freed until
+    * releaseUnusedBlocks() is called.
+    */
+   void
+   setMaxBytesHeld(
+      size_t max_bytes_held)
+   {
+      d_max_bytes_held_limit = max_bytes_held;
+   }
+
+   /*!
+    * @brief Set whether large blocks are backed by huge pages.
+    */
+   void
+   setUseHugePages(
+      bool use_huge_pages)
+   {
+      d_use_huge_pages = use_huge_pages;
+   }
+
+   /*!
+    * @brief Free the blocks held by the pool that are not in use.
+    */
+   void
+   releaseUnusedBlocks();
+
+   /*!
+    * @brief Return the number of bytes in blocks currently in use.
+    */
+   size_t
+   getBytesInUse() const
+   {
+      return d_bytes_in_use;
+   }
+
+   /*!
+    * @brief Return the largest number of bytes in use at any time.
+    */
+   size_t
+   getMaxBytesInUse() const
+   {
+      return d_max_bytes_in_use;
+   }
+
+   /*!
+    * @brief Return the number of bytes in blocks held by the pool and
+    * not in use.
+    */
+   size_t
+   getBytesHeld() const
+   {
+      return d_bytes_held;
+   }
+
+   /*!
+    * @brief Return the number of allocations requested from the pool.
+    */
+   size_t
+   getNumberOfAllocations() const
+   {
+      return d_num_allocations;
+   }
+
+   /*!
+    * @brief Return the number of allocations the pool had to make from
+    * the heap.
+    */
+   size_t
+   getNumberOfHeapAllocations() const
+   {
+      return d_num_heap_allocations;
+   }
+
+   /*!
+    * @brief Reset the statistics.
+    *
+    * The number of bytes in use and held are not changed, but the high
+    * water mark and allocation counts restart from the current state.
+    */
+   void
+   resetStatistics();
+
+   /*!
+    * @brief Write the statistics to the given stream.
+    *
+    * @param[in,out] os
+    */
+   void
+   printStatistics(
+      std::ostream& os) const;
+
+private:
+   AlignedMemoryPool();
+
+   ~AlignedMemoryPool();
+
+   // Unimplemented copy constructor.
+   AlignedMemoryPool(
+      const AlignedMemoryPool& other);
+
+   // Unimplemented assignment operator.
+   AlignedMemoryPool&
+   operator = (
+      const AlignedMemoryPool& rhs);
+
+   /*!
+    * @brief Return the size of the block allocated for num_bytes.
+    */
+   size_t
+   getBlockSize(
+      size_t num_bytes) const;
+
+   /*!
+    * @brief Allocate a block of the given size from the heap.
+    */
+   void *
+   allocateFromHeap(
+      size_t block_size,
+      bool use_huge_pages) const;
+
+   /*!
+    * @brief Read the input parameters.  The lock must be held.
+    */
+   void
+   getFromInput();
+
+   /*!
+    * @brief Free the blocks held by the pool.  The lock must be held.
+    */
+   void
+   freeHeldBlocks();
+
+   /*!
+    * @brief Create the pool before any threads use it.
+    */
+   static void
+   startupCallback();
+
+   /*!
+    * @brief Free the pool.
+    */
+   static void
+   finalizeCallback();
+
+   static const size_t s_alignment = 64;
+   static const size_t s_huge_page_size = 2 * 1024 * 1024;
+   static const size_t s_default_max_bytes_held = 256 * 1024 * 1024;
+
+   /*!
+    * @brief Blocks held by the pool, indexed by block size.
+    */
+   std::map<size_t, std::vector<void *> > d_free_blocks;
+
+   bool d_pooling_enabled;
+   size_t d_max_bytes_held_limit;
+   bool d_use_huge_pages;
+   bool d_read_input;
+
+   size_t d_bytes_in_use;
+   size_t d_max_bytes_in_use;
+   size_t d_bytes_held;
+   size_t d_num_allocations;
+   size_t d_num_heap_allocations;
+
+   /*!
+    * @brief Lock for the pool data, for threaded use.
+    */
+   mutable TBOX_omp_lock_t d_lock;
+
+   static AlignedMemoryPool* s_pool;
+
+   static StartupShutdownManager::Handler s_startup_handler;
+};
+
+}
+}
+
+#endif
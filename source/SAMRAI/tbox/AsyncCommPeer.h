@@ -266,6 +266,9 @@ public:
     * On return, the data in @b buffer would have been copied so it is
     * safe to deallocate or modify @c buffer.
     *
+    * If @c buffer is the one returned by getSendBuffer(), the data is
+    * sent from it without being copied.
+    *
     * @param buffer
     * @param size
     *
@@ -283,6 +286,23 @@ public:
       int size,
       bool automatic_push_to_completion_queue = false);
 
+   /*!
+    * @brief Get the internal buffer, sized to hold a message of
+    * @c size items, so the data can be written directly to it.
+    *
+    * Passing the returned buffer to beginSend() sends the data without
+    * copying it.  The message must fit in the first message, so @c size
+    * may not be more than the limit set by limitFirstDataLength().  The
+    * buffer is valid until the next operation begins.
+    *
+    * @param size
+    *
+    * @pre getNextTaskOp() == none
+    */
+   TYPE *
+   getSendBuffer(
+      size_t size);
+
    /*!
     * @brief Check the current broadcast communication and complete
     * the broadcast if all MPI requests are fulfilled.
@@ -600,7 +620,7 @@ private:
     *
     * Used for sends and receives.  This is typed on FlexData because
     * it must be able to store the templated type TYPE and some integer
-    * for overhead data.
+    * for overhead data.  It is allocated from the MessageBufferPool.
     */
    size_t d_internal_buf_size;
    FlexData* d_internal_buf;
@@ -37,6 +37,8 @@
 namespace SAMRAI {
 namespace tbox {
 
+class MessageStream;
+
 /**
  * @brief Class Database is an abstract base class for the input, restart,
  * and visualization databases.
@@ -1554,6 +1556,196 @@ public:
       putIntegerVector(key, array);
    }
 
+   /**
+    * Get a char array entry from the database with the specified key
+    * name into data, which must hold exactly nelements values.  Unlike
+    * getVector(), the values may be read directly into the caller's
+    * storage.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to fill.
+    * @param nelements Number of elements in the entry.
+    */
+   void
+   getArray(
+      const std::string& key,
+      char* data,
+      const size_t nelements)
+   {
+      getCharArray(key, data, nelements);
+   }
+
+   /**
+    * Create a char array entry in the database with the specified key
+    * name from nelements values at data.  If the key already exists in
+    * the database, then the old key record is deleted and the new one
+    * is silently created in its place.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to put into database.
+    * @param nelements Number of elements to write.
+    */
+   void
+   putArray(
+      const std::string& key,
+      const char* data,
+      const size_t nelements)
+   {
+      putCharArray(key, data, nelements);
+   }
+
+   /**
+    * Get a complex array entry from the database with the specified key
+    * name into data, which must hold exactly nelements values.  Unlike
+    * getVector(), the values may be read directly into the caller's
+    * storage.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to fill.
+    * @param nelements Number of elements in the entry.
+    */
+   void
+   getArray(
+      const std::string& key,
+      dcomplex* data,
+      const size_t nelements)
+   {
+      getComplexArray(key, data, nelements);
+   }
+
+   /**
+    * Create a complex array entry in the database with the specified key
+    * name from nelements values at data.  If the key already exists in
+    * the database, then the old key record is deleted and the new one
+    * is silently created in its place.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to put into database.
+    * @param nelements Number of elements to write.
+    */
+   void
+   putArray(
+      const std::string& key,
+      const dcomplex* data,
+      const size_t nelements)
+   {
+      putComplexArray(key, data, nelements);
+   }
+
+   /**
+    * Get a float array entry from the database with the specified key
+    * name into data, which must hold exactly nelements values.  Unlike
+    * getVector(), the values may be read directly into the caller's
+    * storage.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to fill.
+    * @param nelements Number of elements in the entry.
+    */
+   void
+   getArray(
+      const std::string& key,
+      float* data,
+      const size_t nelements)
+   {
+      getFloatArray(key, data, nelements);
+   }
+
+   /**
+    * Create a float array entry in the database with the specified key
+    * name from nelements values at data.  If the key already exists in
+    * the database, then the old key record is deleted and the new one
+    * is silently created in its place.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to put into database.
+    * @param nelements Number of elements to write.
+    */
+   void
+   putArray(
+      const std::string& key,
+      const float* data,
+      const size_t nelements)
+   {
+      putFloatArray(key, data, nelements);
+   }
+
+   /**
+    * Get a double array entry from the database with the specified key
+    * name into data, which must hold exactly nelements values.  Unlike
+    * getVector(), the values may be read directly into the caller's
+    * storage.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to fill.
+    * @param nelements Number of elements in the entry.
+    */
+   void
+   getArray(
+      const std::string& key,
+      double* data,
+      const size_t nelements)
+   {
+      getDoubleArray(key, data, nelements);
+   }
+
+   /**
+    * Create a double array entry in the database with the specified key
+    * name from nelements values at data.  If the key already exists in
+    * the database, then the old key record is deleted and the new one
+    * is silently created in its place.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to put into database.
+    * @param nelements Number of elements to write.
+    */
+   void
+   putArray(
+      const std::string& key,
+      const double* data,
+      const size_t nelements)
+   {
+      putDoubleArray(key, data, nelements);
+   }
+
+   /**
+    * Get an integer array entry from the database with the specified key
+    * name into data, which must hold exactly nelements values.  Unlike
+    * getVector(), the values may be read directly into the caller's
+    * storage.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to fill.
+    * @param nelements Number of elements in the entry.
+    */
+   void
+   getArray(
+      const std::string& key,
+      int* data,
+      const size_t nelements)
+   {
+      getIntegerArray(key, data, nelements);
+   }
+
+   /**
+    * Create an integer array entry in the database with the specified key
+    * name from nelements values at data.  If the key already exists in
+    * the database, then the old key record is deleted and the new one
+    * is silently created in its place.
+    *
+    * @param key       Key name in database.
+    * @param data      Array to put into database.
+    * @param nelements Number of elements to write.
+    */
+   void
+   putArray(
+      const std::string& key,
+      const int* data,
+      const size_t nelements)
+   {
+      putIntegerArray(key, data, nelements);
+   }
+
    /**
     * Return whether the specified key represents a vector entry.  If
     * the key does not exist, then false is returned.
@@ -1630,6 +1822,33 @@ public:
     */
    virtual void copyDatabase(const std::shared_ptr<Database>& database);
 
+   /*!
+    * @brief Pack the full contents of this database, including nested
+    * databases, into a message stream.
+    *
+    * The packed form can be unpacked into any kind of database with
+    * getFromMessageStream(), for example to ship a database built in
+    * memory on one process to another process that writes it to disk.
+    * Zero-length arrays are not packed.
+    *
+    * @param stream Stream in write mode.
+    */
+   void
+   putToMessageStream(
+      MessageStream& stream);
+
+   /*!
+    * @brief Add the entries packed by putToMessageStream() to this
+    * database.
+    *
+    * Entries whose keys already exist in this database are replaced.
+    *
+    * @param stream Stream in read mode.
+    */
+   void
+   getFromMessageStream(
+      MessageStream& stream);
+
 #ifdef HAVE_CONDUIT
    /*!
     * @brief Write data held in this database to a Conduit Node
@@ -45,6 +45,18 @@ public:
    allocate(
       const std::string& name) = 0;
 
+   /**
+    * Return true if the databases built store the data of all
+    * processors in one shared file.  The RestartManager then writes one
+    * restart file per restore number instead of one per processor.
+    * The default returns false.
+    */
+   virtual bool
+   buildsSharedFileDatabases() const
+   {
+      return false;
+   }
+
 private:
    // Unimplemented copy constructor.
    DatabaseFactory(
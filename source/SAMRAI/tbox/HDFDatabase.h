@@ -320,6 +320,19 @@ public:
    getDoubleVector(
       const std::string& key);
 
+   /**
+    * Read a double array entry with the specified key name directly
+    * into data.  The number of elements must match the entry.
+    *
+    * @pre !key.empty()
+    * @pre isDouble(key)
+    */
+   virtual void
+   getDoubleArray(
+      const std::string& key,
+      double* data,
+      const size_t nelements);
+
    /**
     * Return true or false depending on whether the specified key
     * represents a float entry.  If the key does not exist or if
@@ -354,6 +367,19 @@ public:
    getFloatVector(
       const std::string& key);
 
+   /**
+    * Read a float array entry with the specified key name directly
+    * into data.  The number of elements must match the entry.
+    *
+    * @pre !key.empty()
+    * @pre isFloat(key)
+    */
+   virtual void
+   getFloatArray(
+      const std::string& key,
+      float* data,
+      const size_t nelements);
+
    /**
     * Return true or false depending on whether the specified key
     * represents an integer entry.  If the key does not exist or if
@@ -388,6 +414,19 @@ public:
    getIntegerVector(
       const std::string& key);
 
+   /**
+    * Read a int array entry with the specified key name directly
+    * into data.  The number of elements must match the entry.
+    *
+    * @pre !key.empty()
+    * @pre isInteger(key)
+    */
+   virtual void
+   getIntegerArray(
+      const std::string& key,
+      int* data,
+      const size_t nelements);
+
    /**
     * Return true or false depending on whether the specified key
     * represents a string entry.  If the key does not exist or if
@@ -502,6 +541,36 @@ public:
    virtual std::string
    getName();
 
+   /**
+    * @brief Set the compression of the arrays written to this database
+    * and to the databases later created or opened within it.
+    *
+    * Bool, complex, double, float and integer arrays of at least
+    * min_compressed_bytes bytes in the file are written in chunks of at
+    * most chunk_bytes bytes and compressed with the deflate filter at
+    * deflate_level.  If use_shuffle is true the shuffle filter is
+    * applied first.  It groups the bytes of the values by significance,
+    * which makes smooth floating point fields compress much better.
+    * HDF5 decompresses the data transparently when it is read.
+    *
+    * A deflate_level of 0, the default, writes all arrays contiguous and
+    * uncompressed.  If the HDF5 library has no deflate filter, a warning
+    * is printed and arrays are written uncompressed.
+    *
+    * @param deflate_level Deflate compression level, 0 to 9.
+    * @param use_shuffle Whether to shuffle bytes before compression.
+    * @param min_compressed_bytes Size of the smallest array compressed.
+    * @param chunk_bytes Largest chunk size.
+    *
+    * @pre (deflate_level >= 0) && (deflate_level <= 9)
+    */
+   void
+   setCompression(
+      int deflate_level,
+      bool use_shuffle = true,
+      size_t min_compressed_bytes = 4096,
+      size_t chunk_bytes = 1048576);
+
    /**
     * Return the group_id so VisIt can access an object's HDF database.
     */
@@ -521,11 +590,8 @@ public:
    using Database::putComplexArray;
    using Database::getComplexArray;
    using Database::putFloatArray;
-   using Database::getFloatArray;
    using Database::putDoubleArray;
-   using Database::getDoubleArray;
    using Database::putIntegerArray;
-   using Database::getIntegerArray;
    using Database::putStringArray;
    using Database::getStringArray;
 
@@ -556,6 +622,19 @@ private:
       int type,
       void* database);
 
+   /*
+    * Read the whole dataset of key, which must have nelements elements,
+    * into data as mem_type.  caller names the public function for error
+    * messages.
+    */
+   void
+   readArray(
+      const std::string& key,
+      hid_t mem_type,
+      void* data,
+      const size_t nelements,
+      const char* caller);
+
    /*
     * Private utility routine for inserting array data in the database
     */
@@ -603,6 +682,17 @@ private:
    createCompoundComplex(
       char type_spec) const;
 
+   /*
+    * Return the dataset creation property list for an array of
+    * nelements values of file_type.  This is H5P_DEFAULT when the array
+    * is not compressed.  Otherwise the caller must close the list with
+    * H5Pclose().
+    */
+   hid_t
+   createDatasetProperties(
+      hid_t file_type,
+      size_t nelements) const;
+
    /*
     * Private utility routines for searching keys in database;
     */
@@ -693,6 +783,14 @@ private:
     */
    std::list<KeyData> d_keydata;
 
+   /*
+    * Array compression settings, see setCompression().
+    */
+   int d_deflate_level;
+   bool d_use_shuffle;
+   size_t d_min_compressed_bytes;
+   size_t d_chunk_bytes;
+
    /*
     *************************************************************************
     *
@@ -0,0 +1,289 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   Pool of reusable buffers for interprocessor communication
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_MessageBufferPool
+#define included_tbox_MessageBufferPool
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/tbox/OpenMPUtilities.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
+
+#include <iostream>
+#include <vector>
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Singleton pool of message buffers, used by MessageStream and
+ * AsyncCommPeer.
+ *
+ * Communication phases allocate and free many short-lived buffers of
+ * similar sizes.  This pool keeps freed buffers and hands them out
+ * again, so that repeated communication phases do not allocate from
+ * the heap once the pool holds enough buffers.
+ *
+ * Buffers are grouped in size classes of powers of two bytes, from
+ * getMinimumBufferSize() up to getMaximumBufferSize().  A request is
+ * served from the smallest class that holds it.  Larger requests are
+ * allocated from and returned directly to the heap, without rounding,
+ * since rounding them up would nearly double the largest messages.
+ *
+ * The pool is thread-safe.  It keeps statistics, including the high
+ * water marks of bytes in use and bytes held, which can be written
+ * with printStatistics().
+ *
+ * The pool holds at most getDefaultMaxBytesHeld() bytes of unused
+ * buffers unless changed with setMaxBytesHeld().  Buffers freed beyond
+ * this limit go back to the heap, so that one large exchange does not
+ * pin its memory for the rest of the run.  Held buffers are freed by
+ * releaseUnusedBuffers() and at SAMRAI finalization.  If buffers are
+ * still in use at finalization, the pool is kept for them to be
+ * returned to, and they are freed when returned.
+ */
+class MessageBufferPool
+{
+public:
+   /*!
+    * @brief Get the pool.
+    */
+   static MessageBufferPool *
+   getPool();
+
+   /*!
+    * @brief Get a buffer of at least num_bytes bytes.
+    *
+    * The buffer has the alignment of malloc.  Its contents are
+    * undefined.
+    *
+    * @param[in] num_bytes
+    *
+    * @return The buffer, or 0 if num_bytes is zero.
+    */
+   void *
+   allocate(
+      size_t num_bytes);
+
+   /*!
+    * @brief Give a buffer from allocate() back to the pool.
+    *
+    * @param[in] buffer  The buffer.  Nothing is done if it is 0.
+    * @param[in] num_bytes  The size given to allocate() for the buffer.
+    */
+   void
+   deallocate(
+      void* buffer,
+      size_t num_bytes);
+
+   /*!
+    * @brief Return the number of bytes actually available in a buffer
+    * allocated for num_bytes bytes.
+    *
+    * Users may use the whole buffer, and a buffer may be given back with
+    * any size between num_bytes and the returned value.
+    *
+    * @param[in] num_bytes
+    */
+   static size_t
+   getAllocationSize(
+      size_t num_bytes);
+
+   /*!
+    * @brief Return the size of the smallest size class.
+    */
+   static size_t
+   getMinimumBufferSize()
+   {
+      return static_cast<size_t>(1) << s_min_class_exponent;
+   }
+
+   /*!
+    * @brief Return the size of the largest size class.
+    *
+    * Larger buffers are not kept by the pool.
+    */
+   static size_t
+   getMaximumBufferSize()
+   {
+      return static_cast<size_t>(1) << s_max_class_exponent;
+   }
+
+   /*!
+    * @brief Return the default limit on the number of bytes held by
+    * the pool and not in use.
+    */
+   static size_t
+   getDefaultMaxBytesHeld()
+   {
+      return s_default_max_bytes_held;
+   }
+
+   /*!
+    * @brief Set the limit on the number of bytes held by the pool and
+    * not in use.
+    *
+    * Buffers held beyond the new limit are not freed until
+    * releaseUnusedBuffers() is called.
+    */
+   void
+   setMaxBytesHeld(
+      size_t max_bytes_held)
+   {
+      d_max_bytes_held_limit = max_bytes_held;
+   }
+
+   /*!
+    * @brief Free the buffers held by the pool that are not in use.
+    */
+   void
+   releaseUnusedBuffers();
+
+   /*!
+    * @brief Return the number of bytes in buffers currently in use.
+    */
+   size_t
+   getBytesInUse() const
+   {
+      return d_bytes_in_use;
+   }
+
+   /*!
+    * @brief Return the largest number of bytes in use at any time.
+    */
+   size_t
+   getMaxBytesInUse() const
+   {
+      return d_max_bytes_in_use;
+   }
+
+   /*!
+    * @brief Return the number of bytes in buffers held by the pool and
+    * not in use.
+    */
+   size_t
+   getBytesHeld() const
+   {
+      return d_bytes_held;
+   }
+
+   /*!
+    * @brief Return the largest number of bytes held at any time.
+    */
+   size_t
+   getMaxBytesHeld() const
+   {
+      return d_max_bytes_held;
+   }
+
+   /*!
+    * @brief Return the number of allocations requested from the pool.
+    */
+   size_t
+   getNumberOfAllocations() const
+   {
+      return d_num_allocations;
+   }
+
+   /*!
+    * @brief Return the number of allocations the pool had to make from
+    * the heap.
+    */
+   size_t
+   getNumberOfHeapAllocations() const
+   {
+      return d_num_heap_allocations;
+   }
+
+   /*!
+    * @brief Reset the statistics.
+    *
+    * The number of bytes in use and held are not changed, but the high
+    * water mark and allocation counts restart from the current state.
+    */
+   void
+   resetStatistics();
+
+   /*!
+    * @brief Write the statistics to the given stream.
+    *
+    * @param[in,out] os
+    */
+   void
+   printStatistics(
+      std::ostream& os) const;
+
+private:
+   MessageBufferPool();
+
+   ~MessageBufferPool();
+
+   // Unimplemented copy constructor.
+   MessageBufferPool(
+      const MessageBufferPool& other);
+
+   // Unimplemented assignment operator.
+   MessageBufferPool&
+   operator = (
+      const MessageBufferPool& rhs);
+
+   /*!
+    * @brief Return the size class for num_bytes, or s_num_classes if
+    * num_bytes is too big for the pool.
+    */
+   static int
+   getSizeClass(
+      size_t num_bytes);
+
+   /*!
+    * @brief Create the pool before any threads use it.
+    */
+   static void
+   startupCallback();
+
+   /*!
+    * @brief Free the pool, or only its held buffers if any buffers are
+    * still in use.
+    */
+   static void
+   finalizeCallback();
+
+   static const int s_min_class_exponent = 6;
+   static const int s_max_class_exponent = 24;
+   static const int s_num_classes =
+      s_max_class_exponent - s_min_class_exponent + 1;
+   static const size_t s_default_max_bytes_held = 128 * 1024 * 1024;
+
+   /*!
+    * @brief Buffers held by the pool, indexed by size class.
+    */
+   std::vector<std::vector<void *> > d_free_buffers;
+
+   size_t d_max_bytes_held_limit;
+   size_t d_bytes_in_use;
+   size_t d_max_bytes_in_use;
+   size_t d_bytes_held;
+   size_t d_max_bytes_held;
+   size_t d_num_allocations;
+   size_t d_num_heap_allocations;
+
+   /*!
+    * @brief Lock for the pool data, for threaded use.
+    */
+   mutable TBOX_omp_lock_t d_lock;
+
+   static MessageBufferPool* s_pool;
+
+   static StartupShutdownManager::Handler s_startup_handler;
+};
+
+}
+}
+
+#endif
@@ -14,11 +14,11 @@
 #include "SAMRAI/SAMRAI_config.h"
 
 #include "SAMRAI/tbox/Complex.h"
+#include "SAMRAI/tbox/MessageBufferPool.h"
 #include "SAMRAI/tbox/Utilities.h"
 
 #include <cstring>
 #include <iostream>
-#include <vector>
 
 namespace SAMRAI {
 namespace tbox {
@@ -28,6 +28,8 @@ namespace tbox {
  *
  * MessageStream provides a message buffer that can hold data of any
  * type.  It is used by communication routines in the Schedule class.
+ * Write-mode buffers and deep copies of read buffers come from the
+ * MessageBufferPool.
  *
  * TODO: Because this class supports both read and write modes, it has
  * extra data and methods that don't make sense, depending on the
@@ -72,6 +74,28 @@ public:
       const void* data_to_read = 0,
       bool deep_copy = true);
 
+   /*!
+    * @brief Create a Write-mode message stream that writes directly
+    * into an external buffer.
+    *
+    * This lets data be packed where it will be sent from, such as the
+    * buffer from AsyncCommPeer::getSendBuffer(), without an extra
+    * copy.  The stream does not own the buffer.  If more than num_bytes
+    * bytes are written, the data is moved to a larger buffer from the
+    * MessageBufferPool, and getBufferStart() no longer returns
+    * write_buffer.
+    *
+    * @param[in] num_bytes   Number of bytes in the buffer.
+    *
+    * @param[in] write_buffer  The buffer to write to.
+    *
+    * @pre num_bytes >= 1
+    * @pre write_buffer != 0
+    */
+   MessageStream(
+      const size_t num_bytes,
+      void* write_buffer);
+
    /*!
     * @brief Default constructor creates a message stream with a
     * buffer that automatically grows as needed, for writing.
@@ -113,7 +137,7 @@ public:
       if (d_mode == Read) {
          return static_cast<const void *>(d_read_buffer);
       } else {
-         return &d_write_buffer[0];
+         return static_cast<const void *>(d_write_buffer);
       }
    }
 
@@ -191,8 +215,8 @@ public:
       TBOX_ASSERT(writeMode());
       const size_t num_bytes = getSizeof<DATA_TYPE>(num_entries);
       if (num_bytes > 0) {
-         d_write_buffer.resize(getCurrentSize() + num_bytes);
-         d_buffer_size = d_write_buffer.size();
+         reserveWriteBuffer(getCurrentSize() + num_bytes);
+         d_buffer_size = getCurrentSize() + num_bytes;
       }
       DATA_TYPE *buffer =
          reinterpret_cast<DATA_TYPE *>(&d_write_buffer[getCurrentSize()]);
@@ -345,7 +369,7 @@ public:
    canCopyIn(
       size_t num_bytes) const
    {
-      return d_buffer_index + num_bytes <= d_write_buffer.capacity();
+      return d_buffer_index + num_bytes <= d_write_capacity;
    }
 
    /*!
@@ -375,14 +399,36 @@ private:
          TBOX_ASSERT(canCopyIn(num_bytes));
       }
       if (num_bytes > 0) {
-         d_write_buffer.insert(d_write_buffer.end(),
-            static_cast<const char *>(input_data),
-            static_cast<const char *>(input_data) + num_bytes);
-         d_buffer_size = d_write_buffer.size();
+         reserveWriteBuffer(d_buffer_index + num_bytes);
+         memcpy(&d_write_buffer[d_buffer_index], input_data, num_bytes);
          d_buffer_index += num_bytes;
+         d_buffer_size = d_buffer_index;
+      }
+   }
+
+   /*!
+    * @brief Make sure the write buffer can hold num_bytes bytes,
+    * growing it geometrically if needed.
+    *
+    * @param[in]  num_bytes
+    */
+   void reserveWriteBuffer(
+      const size_t num_bytes)
+   {
+      if (num_bytes > d_write_capacity) {
+         growWriteBuffer(num_bytes);
       }
    }
 
+   /*!
+    * @brief Replace the write buffer with a larger one from the
+    * MessageBufferPool, keeping the data written so far.
+    *
+    * @param[in]  num_bytes  Minimum size of the new buffer.
+    */
+   void growWriteBuffer(
+      const size_t num_bytes);
+
    /*!
     * @brief Copy data out of the stream, advancing the stream pointer.
     *
@@ -414,7 +460,18 @@ private:
    /*!
     * The buffer for the streamed data to be written.
     */
-   std::vector<char> d_write_buffer;
+   char* d_write_buffer;
+
+   /*!
+    * @brief Number of bytes allocated for d_write_buffer.
+    */
+   size_t d_write_capacity;
+
+   /*!
+    * @brief True if d_write_buffer is externally supplied memory that
+    * the stream may not free.
+    */
+   bool d_external_write_buffer;
 
    /*!
     * @brief Pointer to the externally supplied memory to read from in
@@ -426,7 +483,7 @@ private:
    /*!
     * @brief Number of bytes in the buffer.
     *
-    * Equal to d_write_buffer.size() in write mode, size of supplied external
+    * Number of bytes written in write mode, size of supplied external
     * buffer size in read mode.
     */
    size_t d_buffer_size;
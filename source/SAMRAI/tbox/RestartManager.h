@@ -108,6 +108,19 @@ public:
     * mounts the restart file.
     * Returns true if open is successful; false otherwise.
     *
+    * num_nodes is the number of processors that wrote the restart file.
+    * With a factory building shared file databases, such as
+    * SharedFileDatabaseFactory, all processors open the one shared
+    * file, and num_nodes may differ from the current number of
+    * processors.  See SharedFileDatabase for what each processor then
+    * reads.
+    *
+    * num_nodes may also differ from the current number of processors
+    * with per processor restart files.  Each processor then opens the
+    * file of the processor with its rank, or that of processor 0 if
+    * there is no such file, to restore the data that is the same on all
+    * processors.  See isRedistributedRestart().
+    *
     * @pre hasDatabaseFactory()
     */
    bool
@@ -116,6 +129,40 @@ public:
       const int restore_num,
       const int num_nodes);
 
+   /**
+    * Returns the number of processors that wrote the restart file
+    * opened with openRestartFile(), or 0 if no restart file was opened.
+    */
+   int
+   getNumberOfRestartProcessors() const
+   {
+      return d_restart_num_nodes;
+   }
+
+   /**
+    * Returns true if the restart file opened with openRestartFile() was
+    * written by a different number of processors than the current one.
+    * Objects whose restart data differ between processors, such as the
+    * patches of a PatchHierarchy, must then redistribute that data
+    * instead of restoring the data of their own processor.
+    */
+   bool
+   isRedistributedRestart() const;
+
+   /**
+    * Opens the restart file written by processor stored_rank for the
+    * restart opened with openRestartFile(), and returns the root of its
+    * database.  Unlike openRestartFile(), this is not collective, and a
+    * processor may open the file of any of the processors that wrote the
+    * restart.  The caller closes the returned database.
+    *
+    * @pre isFromRestart()
+    * @pre (stored_rank >= 0) && (stored_rank < getNumberOfRestartProcessors())
+    */
+   std::shared_ptr<Database>
+   openStoredProcessorRestartFile(
+      int stored_rank);
+
    /**
     * Closes the restart file.
     */
@@ -168,6 +215,25 @@ public:
       d_database_factory = database_factory;
    }
 
+   /**
+    * @brief Set the array compression of HDF restart files.
+    *
+    * The settings are applied to each restart file written by
+    * writeRestartFile(const std::string&, int) whose database is an
+    * HDFDatabase.  Restart files of any compression are read back
+    * transparently.  See HDFDatabase::setCompression() for the meaning
+    * of the arguments.  A deflate_level of 0, the default, writes
+    * uncompressed restart files.
+    *
+    * @pre (deflate_level >= 0) && (deflate_level <= 9)
+    */
+   void
+   setHDFCompression(
+      int deflate_level,
+      bool use_shuffle = true,
+      size_t min_compressed_bytes = 4096,
+      size_t chunk_bytes = 1048576);
+
    /*!
     * @brief Returns true if the database for restore or dumps has been set.
     */
@@ -228,6 +294,9 @@ public:
     * root of restart directory.  The integer argument is the
     * identification number associated with the restart files generated.
     *
+    * With a factory building shared file databases this is collective,
+    * and all processors write one restart file.
+    *
     * @pre hasDatabaseFactory()
     */
    void
@@ -300,12 +369,31 @@ private:
     *     restore.[restore number]/
     *       nodes.[number of processors]/
     *         proc.[processor number]
+    *
+    * With shared file databases the nodes directory holds the single
+    * file restart.shared instead of the per processor files.
     */
    std::string
    createDirs(
       const std::string& root_dirname,
       int restore_num);
 
+   /*
+    * Returns the name of the restart file of processor proc_num within
+    * its nodes directory.
+    */
+   std::string
+   getRestartFileName(
+      int proc_num);
+
+   /*
+    * Returns the full path of the restart file of processor proc_num
+    * for the restart opened with openRestartFile().
+    */
+   std::string
+   getRestartFilePath(
+      int proc_num);
+
    struct RestartItem {
       std::string name;
       Serializable* obj;
@@ -334,8 +422,25 @@ private:
     */
    std::shared_ptr<DatabaseFactory> d_database_factory;
 
+   /*
+    * Array compression settings for HDF restart files, see
+    * setHDFCompression().
+    */
+   int d_hdf_deflate_level;
+   bool d_hdf_use_shuffle;
+   size_t d_hdf_min_compressed_bytes;
+   size_t d_hdf_chunk_bytes;
+
    bool d_is_from_restart;
 
+   /*
+    * Directory, restore number and number of processors of the restart
+    * opened with openRestartFile().
+    */
+   std::string d_restart_root_dirname;
+   int d_restart_restore_num;
+   int d_restart_num_nodes;
+
    static StartupShutdownManager::Handler s_shutdown_handler;
 };
 
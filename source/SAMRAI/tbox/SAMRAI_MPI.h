@@ -119,12 +119,14 @@ public:
    typedef MPI_Op Op;
    typedef MPI_Request Request;
    typedef MPI_Status Status;
+   typedef MPI_User_function User_function;
 #else
    typedef int Comm;
    typedef int Datatype;
    typedef int Group;
    typedef int Op;
    typedef int Request;
+   typedef void User_function(void *, void *, int *, Datatype *);
 
    /*!
     * @brief Dummy definition of Status to match the MPI standard.
@@ -401,6 +403,16 @@ public:
       Datatype datatype,
       int* count);
 
+   static int
+   Op_create(
+      User_function* function,
+      int commute,
+      Op* op);
+
+   static int
+   Op_free(
+      Op* op);
+
    static int
    Request_free(
       Request* request);
@@ -22,6 +22,7 @@
 #include <map>
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace tbox {
@@ -138,6 +139,7 @@ public:
       const SAMRAI_MPI& mpi)
    {
       d_mpi = mpi;
+      resetPersistentData();
    }
 
    /*!
@@ -160,6 +162,7 @@ public:
       TBOX_ASSERT(second_tag >= 0);
       d_first_tag = first_tag;
       d_second_tag = second_tag;
+      resetPersistentData();
    }
 
    /*!
@@ -202,6 +205,7 @@ public:
    {
       TBOX_ASSERT(first_message_length > 0);
       d_first_message_length = static_cast<size_t>(first_message_length);
+      resetPersistentData();
    }
 
    /*!
@@ -248,6 +252,115 @@ public:
       d_unpack_in_deterministic_order = flag;
    }
 
+   /*!
+    * @brief Set whether to execute transactions using multiple threads.
+    *
+    * When set, local copies are distributed over OpenMP threads, the
+    * outgoing messages for different peers are packed concurrently
+    * and the incoming messages from different peers are unpacked
+    * concurrently.  This is only valid when no two transactions of the
+    * schedule write the same destination entries.  Transactions that
+    * sum into their destinations, such as those of
+    * algs::PatchBoundaryNodeSum, and fills of data living on patch
+    * borders, where neighboring patches share entries, do not qualify.
+    *
+    * If deterministic unpack ordering is requested (see
+    * setDeterministicUnpackOrderingFlag()), unpacking of received
+    * messages stays serial in order of sender rank; only the local
+    * copies and packing are threaded.
+    *
+    * Without OpenMP, this flag has no effect.  The default is false.
+    * xfer::RefineSchedule and xfer::CoarsenSchedule set it to
+    * getDefaultThreadedExecutionFlag() when none of their data lives
+    * on patch borders.
+    *
+    * @param [in] flag
+    */
+   void setThreadedExecutionFlag(bool flag)
+   {
+      d_threaded_execution = flag;
+   }
+
+   /*!
+    * @brief Return whether transactions are executed using multiple
+    * threads.
+    *
+    * @see setThreadedExecutionFlag()
+    */
+   bool getThreadedExecutionFlag() const
+   {
+      return d_threaded_execution;
+   }
+
+   /*!
+    * @brief Return the input parameter "threaded_execution" in the
+    * "Schedule" input database, or false if it is not given.
+    *
+    * The input is read when the first Schedule is constructed.  Only
+    * schedules known to write disjoint destinations should use this as
+    * their threaded execution flag.
+    *
+    * @see setThreadedExecutionFlag()
+    */
+   static bool getDefaultThreadedExecutionFlag()
+   {
+      return s_default_threaded_execution;
+   }
+
+   /*!
+    * @brief Set whether to keep communication objects and message
+    * sizes from one communication to the next.
+    *
+    * Schedules are usually built once and then communicate many times
+    * with the same message sizes.  In persistent mode, the peer
+    * communication objects and their message buffers are kept after
+    * the first communication and reused, and the sizes of messages
+    * that can be computed locally are computed only once.  This
+    * removes the allocation and size computation costs from
+    * subsequent communications.
+    *
+    * Persistent data is discarded by resetPersistentData(), which is
+    * called automatically when transactions are added or the MPI
+    * parameters change.  Owners of schedules must call it when the
+    * data communicated by existing transactions changes size.
+    *
+    * The default is set by the input parameter
+    * "persistent_communication" in the "Schedule" input database, or
+    * false if it is not given.
+    *
+    * @param [in] flag
+    */
+   void setPersistentCommunicationFlag(bool flag)
+   {
+      if (!flag) {
+         resetPersistentData();
+      }
+      d_persistent_communication = flag;
+   }
+
+   /*!
+    * @brief Return whether communication objects and message sizes
+    * are kept between communications.
+    *
+    * @see setPersistentCommunicationFlag()
+    */
+   bool getPersistentCommunicationFlag() const
+   {
+      return d_persistent_communication;
+   }
+
+   /*!
+    * @brief Discard communication objects and message sizes kept by
+    * persistent communication.
+    *
+    * They are recreated by the next communication.  This method must
+    * not be called during a communication phase.
+    *
+    * @see setPersistentCommunicationFlag()
+    */
+   void
+   resetPersistentData();
+
    /*!
     * @brief Setup names of timers.
     *
@@ -271,6 +384,9 @@ public:
 
    /*!
     * @brief Returns true if the communication objects have been allocated.
+    *
+    * In persistent mode, communication objects remain allocated
+    * between communications.
     */
    bool
    allocatedCommunicationObjects()
@@ -305,11 +421,77 @@ private:
    postSends();
    void
    performLocalCopies();
+
+   /*!
+    * @brief Compute the size of the message for the given outgoing
+    * transactions, or get it from d_persistent_message_sizes.
+    *
+    * @param[in] icom Index of the communication object in d_coms.
+    * @param[in] transactions
+    * @param[out] can_estimate_incoming_message_size Whether the
+    * receiver can compute the message size without being told.
+    */
+   size_t
+   computeOutgoingMessageSize(
+      size_t icom,
+      const std::list<std::shared_ptr<Transaction> >& transactions,
+      bool& can_estimate_incoming_message_size);
+
+   /*!
+    * @brief Get the buffer of send_com to pack an outgoing message into
+    * directly, saving a copy.
+    *
+    * This is possible only if the receiver can compute the message size,
+    * so that the message is sent whole in the first message.
+    *
+    * @param[in,out] send_com
+    * @param[in] byte_count Size of the message.
+    * @param[in] can_estimate_incoming_message_size
+    *
+    * @return The buffer, or 0 if the message must be packed elsewhere.
+    */
+   char *
+   getSendBuffer(
+      AsyncCommPeer<char>& send_com,
+      size_t byte_count,
+      bool can_estimate_incoming_message_size);
+
+   /*!
+    * @brief Pack the given outgoing transactions into a message.
+    */
+   void
+   packOutgoingMessage(
+      const std::list<std::shared_ptr<Transaction> >& transactions,
+      MessageStream& outgoing_stream) const;
+
+   /*!
+    * @brief Begin the non-blocking send of a packed message.
+    *
+    * @param[in,out] send_com
+    * @param[in] outgoing_stream The packed message.
+    * @param[in] byte_count Size of the message computed before packing,
+    * which is what the receiver expects.
+    * @param[in] can_estimate_incoming_message_size
+    */
+   void
+   postSend(
+      AsyncCommPeer<char>& send_com,
+      const MessageStream& outgoing_stream,
+      size_t byte_count,
+      bool can_estimate_incoming_message_size);
    void
    processCompletedCommunications();
    void
    deallocateSendBuffers();
 
+   /*!
+    * @brief Unpack the given completed receives, each on its own
+    * thread when threaded execution is on.
+    */
+   void
+   unpackCompletedReceives(
+      const std::vector<AsyncCommPeer<char> *>& completed_recvs);
+
    Schedule(
       const Schedule&);                 // not implemented
    Schedule&
@@ -400,9 +582,35 @@ private:
     */
    bool d_unpack_in_deterministic_order;
 
+   /*!
+    * @brief Whether to execute transactions using multiple threads.
+    *
+    * @see setThreadedExecutionFlag()
+    */
+   bool d_threaded_execution;
+
+   /*!
+    * @brief Whether to keep communication objects and message sizes
+    * between communications.
+    *
+    * @see setPersistentCommunicationFlag()
+    */
+   bool d_persistent_communication;
+
+   /*!
+    * @brief Message sizes kept for persistent communication, indexed
+    * like d_coms.
+    *
+    * Sizes are only kept for messages whose size the receiver can
+    * compute.  Other entries are s_unknown_message_size and are
+    * recomputed for every communication.
+    */
+   std::vector<size_t> d_persistent_message_sizes;
+
    static const int s_default_first_tag;
    static const int s_default_second_tag;
    static const size_t s_default_first_message_length;
+   static const size_t s_unknown_message_size;
 
    //@{
    //! @name Timer data for Schedule class.
@@ -439,6 +647,18 @@ private:
 
    static char s_ignore_external_timer_prefix;
 
+   /*!
+    * @brief Default for d_threaded_execution, from the input
+    * parameter "threaded_execution".
+    */
+   static bool s_default_threaded_execution;
+
+   /*!
+    * @brief Default for d_persistent_communication, from the input
+    * parameter "persistent_communication".
+    */
+   static bool s_default_persistent_communication;
+
    /*!
     * @brief Structure of timers in s_static_timers, matching this
     * object's timer prefix.
@@ -0,0 +1,201 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   A memory database stored in a file shared by all processors
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_SharedFileDatabase
+#define included_tbox_SharedFileDatabase
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/MemoryDatabase.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+
+#include <string>
+#include <vector>
+
+namespace SAMRAI {
+namespace tbox {
+
+/**
+ * Class SharedFileDatabase is a MemoryDatabase that all processors of
+ * a communicator store in a single file.  Each processor builds its
+ * database in memory.  Closing a database created with create() packs
+ * the database of every processor into the file.  This is collective:
+ * all processors of the communicator must create and close the same
+ * file together.
+ *
+ * The file starts with an index giving the offset and size of the
+ * block of each processor, followed by the blocks.  A block is a
+ * database packed by Database::putToMessageStream().  With MPI the
+ * blocks are written and read with collective MPI-IO, so the file
+ * system sees one file and large contiguous requests instead of a file
+ * per processor.  The file is in the byte order of the machine that
+ * wrote it.
+ *
+ * Opening a file with open() is also collective, and each processor
+ * reads one block.  When the file was written by as many processors as
+ * there are now, each processor reads its own block.  Otherwise
+ * processor r reads block r if the file has one and block 0 if not,
+ * which restores data that is the same on all processors.  Data that
+ * differs between processors, such as the patch data on a level, must
+ * be redistributed by the caller.  openStoredProcessor() reads the
+ * block of any processor independently of the others for this purpose.
+ *
+ * The SharedFileDatabaseFactory builds these databases for the
+ * RestartManager, which then writes a single restart file per restore
+ * number.
+ *
+ * @see SharedFileDatabaseFactory
+ * @see RestartManager
+ */
+
+class SharedFileDatabase:public MemoryDatabase
+{
+public:
+   /**
+    * Create an empty database with the specified name, shared by the
+    * processors of the given communicator.
+    */
+   explicit SharedFileDatabase(
+      const std::string& name,
+      const SAMRAI_MPI& mpi = SAMRAI_MPI::getSAMRAIWorld());
+
+   /**
+    * The destructor does not write the file, because writing is
+    * collective.  A database created with create() must be closed with
+    * close() before it is destroyed.
+    *
+    * @pre a database created with create() has been closed
+    */
+   virtual ~SharedFileDatabase();
+
+   /**
+    * Create a new database to be written to the named file on close().
+    *
+    * Returns true if successful.
+    *
+    * @param name name of the file.
+    */
+   virtual bool
+   create(
+      const std::string& name);
+
+   /**
+    * Open the named file and read this processor's block.  This is
+    * collective over the communicator.  See the class documentation
+    * for which block each processor reads.
+    *
+    * Returns true if successful.
+    *
+    * @param name name of the file.
+    * @param read_write_mode Ignored.  The database read is always
+    * modifiable in memory, and is never written back.
+    */
+   virtual bool
+   open(
+      const std::string& name,
+      const bool read_write_mode = false);
+
+   /**
+    * Open the named file and read the block of stored processor
+    * stored_rank.  Unlike open(), this is not collective.
+    *
+    * Returns true if successful.
+    *
+    * @pre stored_rank >= 0
+    */
+   bool
+   openStoredProcessor(
+      const std::string& name,
+      int stored_rank);
+
+   /**
+    * Close the database.  If it was created with create(), the blocks
+    * of all processors are written to the file, which is collective.
+    *
+    * Returns true if successful.
+    */
+   virtual bool
+   close();
+
+   /**
+    * Return the number of processors that wrote the file last opened,
+    * or 0 if no file has been opened.
+    */
+   int
+   getNumberOfStoredProcessors() const
+   {
+      return static_cast<int>(d_block_sizes.size());
+   }
+
+private:
+   // Unimplemented copy constructor.
+   SharedFileDatabase(
+      const SharedFileDatabase& other);
+
+   // Unimplemented assignment operator.
+   SharedFileDatabase&
+   operator = (
+      const SharedFileDatabase& rhs);
+
+   /*
+    * Write the blocks of all processors and the index to d_filename.
+    */
+   void
+   writeFile();
+
+   /*
+    * Read the index of the named file into d_block_offsets and
+    * d_block_sizes.  Only processor 0 of mpi reads the file, then
+    * broadcasts the index.
+    */
+   void
+   readIndex(
+      const std::string& name,
+      const SAMRAI_MPI& mpi);
+
+   /*
+    * Read the block of stored processor stored_rank, using collective
+    * reads over mpi, and unpack it into this database.
+    */
+   void
+   readBlock(
+      const std::string& name,
+      const SAMRAI_MPI& mpi,
+      int stored_rank);
+
+   /*
+    * Mark at the start of the file, and the file format version.
+    */
+   static const char* const SHARED_FILE_MAGIC;
+   static const long long SHARED_FILE_VERSION;
+
+   /*
+    * Communicator of the processors sharing the file.
+    */
+   SAMRAI_MPI d_mpi;
+
+   /*
+    * Name of the file to write on close(), empty unless the database
+    * was created with create().
+    */
+   std::string d_filename;
+
+   /*
+    * Index of the file last opened: the offset and size of the block of
+    * each stored processor.
+    */
+   std::vector<long long> d_block_offsets;
+   std::vector<long long> d_block_sizes;
+};
+
+}
+}
+
+#endif
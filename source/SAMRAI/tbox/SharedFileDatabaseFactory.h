@@ -0,0 +1,70 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2018 Lawrence Livermore National Security, LLC
+ * Description:   A factory for building SharedFileDatabases
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_SharedFileDatabaseFactory
+#define included_tbox_SharedFileDatabaseFactory
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/tbox/DatabaseFactory.h"
+
+namespace SAMRAI {
+namespace tbox {
+
+/**
+ * @brief SharedFileDatabase factory.
+ *
+ * Builds a new SharedFileDatabase on the SAMRAI world communicator.
+ * Give it to RestartManager::setDatabaseFactory() to write restart
+ * files shared by all processors.
+ */
+class SharedFileDatabaseFactory:public DatabaseFactory
+{
+public:
+   /**
+    * Default constructor.
+    */
+   SharedFileDatabaseFactory();
+
+   /**
+    * Copy constructor.
+    */
+   SharedFileDatabaseFactory(
+      const SharedFileDatabaseFactory& other);
+
+   /**
+    * Assignment operator.
+    */
+   SharedFileDatabaseFactory&
+   operator = (
+      const SharedFileDatabaseFactory& rhs);
+
+   /**
+    * Destructor.
+    */
+   ~SharedFileDatabaseFactory();
+
+   /**
+    * Build a new Database object.
+    */
+   virtual std::shared_ptr<Database>
+   allocate(
+      const std::string& name);
+
+   /**
+    * Return true, the databases built share one file.
+    */
+   virtual bool
+   buildsSharedFileDatabases() const;
+};
+
+}
+}
+
+#endif
@@ -405,6 +405,8 @@ private:
     * @brief Priorities for standard SAMRAI classes
     */
    static const unsigned char priorityArenaManager = 10;
+   static const unsigned char priorityAlignedMemoryPool = 12;
+   static const unsigned char priorityMessageBufferPool = 15;
    static const unsigned char priorityReferenceCounter = 20;
    static const unsigned char priorityLogger = 25;
    static const unsigned char priorityListElements = 30;
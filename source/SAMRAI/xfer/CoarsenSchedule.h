@@ -325,6 +325,12 @@ private:
    hier::IntVector
    getMaxGhostsToGrow() const;
 
+   /*!
+    * @brief Get whether there is data living on patch borders.
+    */
+   bool
+   getDataOnPatchBorderFlag() const;
+
    /*!
     * @brief Construct schedule transactions that communicate or copy coarsened
     * data from temporary coarse level to the destination level.